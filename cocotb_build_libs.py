@@ -518,10 +518,14 @@ def _get_common_lib_ext(include_dirs, share_lib_dir):
     libgpilog_sources = [os.path.join(share_lib_dir, "gpi_log", "gpi_logging.cpp")]
     if os.name == "nt":
         libgpilog_sources += ["libgpilog.rc"]
+    libgpilog_libraries = []
+    if sys.platform.startswith(("linux", "cygwin", "msys")):
+        libgpilog_libraries.append("pthread")  # asynchronous log writer thread
     libgpilog = Extension(
         os.path.join("cocotb", "libs", "libgpilog"),
         define_macros=[("GPILOG_EXPORTS", ""), *_extra_defines],
         include_dirs=include_dirs,
+        libraries=libgpilog_libraries,
         sources=libgpilog_sources,
     )
 
@@ -579,6 +583,8 @@ def _get_common_lib_ext(include_dirs, share_lib_dir):
     libgpi_sources = [
         os.path.join(share_lib_dir, "gpi", "GpiCbHdl.cpp"),
         os.path.join(share_lib_dir, "gpi", "GpiCommon.cpp"),
+        os.path.join(share_lib_dir, "gpi", "GpiMemImage.cpp"),
+        os.path.join(share_lib_dir, "gpi", "GpiTrace.cpp"),
     ]
     if os.name == "nt":
         libgpi_sources += ["libgpi.rc"]
@@ -14,8 +14,11 @@ from typing import (
     Any,
     Callable,
     ClassVar,
+    Dict,
     Generic,
+    List,
     Optional,
+    Tuple,
     TypeVar,
     Union,
 )
@@ -31,6 +34,7 @@ from cocotb.utils import get_sim_steps, get_time_from_sim_steps
 
 if TYPE_CHECKING:
     from cocotb._py_compat import Self
+    from cocotb.types import LogicArray
 
 
 class GPITrigger(Trigger):
@@ -348,6 +352,197 @@ class ValueChange(_EdgeBase["cocotb.handle._NonIndexableValueObjectBase[Any, Any
         return signal.value_change
 
 
+def _bits_of(
+    signal: "cocotb.handle.LogicArrayObject", value: Any, name: str
+) -> str:
+    n = len(signal)
+    if isinstance(value, int):
+        if not 0 <= value < 2**n:
+            raise ValueError(f"{name} {value} doesn't fit in {n} bits")
+        return format(value, f"0{n}b")
+    binstr = str(value)
+    if len(binstr) != n:
+        raise ValueError(
+            f"{name} {binstr!r} doesn't have the {n} bits of {signal!r}"
+        )
+    return binstr
+
+
+class MaskedValueChange(GPITrigger):
+    """Fires when the bits of *signal* selected by *mask* change.
+
+    If *value* is given, only fires when those bits change to the matching bits of *value*.
+    Changes of other bits are filtered out before they reach Python,
+    so this is much cheaper than awaiting :class:`ValueChange` and checking the value
+    when watching a few bits of a wide, busy bus.
+
+    Args:
+        signal: The logic vector to watch.
+        mask: The bits to watch, as an :class:`int`, or a :class:`~cocotb.types.LogicArray` or :class:`str` the width of *signal*.
+        value: The value the watched bits must reach, in the same forms as *mask*.
+
+    Raises:
+        TypeError: If *signal* is not a :class:`~cocotb.handle.LogicArrayObject`.
+        ValueError: If *mask* or *value* doesn't fit *signal*,
+            or if *mask* doesn't select any bits.
+
+    .. versionadded:: 2.1
+    """
+
+    def __init__(
+        self,
+        signal: "cocotb.handle.LogicArrayObject",
+        mask: Union[int, str, "LogicArray"],
+        value: Union[int, str, "LogicArray", None] = None,
+    ) -> None:
+        if not isinstance(signal, cocotb.handle.LogicArrayObject):
+            raise TypeError(
+                f"{type(self).__qualname__} requires a LogicArrayObject. Got {signal!r} of type {type(signal).__qualname__}"
+            )
+        super().__init__()
+        self.signal = signal
+        self._mask = _bits_of(signal, mask, "Mask")
+        if "1" not in self._mask:
+            raise ValueError(f"Mask {mask!r} doesn't select any bits of {signal!r}")
+        self._value = None if value is None else _bits_of(signal, value, "Value")
+
+    def _prime(self, callback: Callable[["Self"], None]) -> None:
+        if self._cbhdl is None:
+            self._cbhdl = simulator.register_masked_value_change_callback(
+                self.signal._handle, callback, self._mask, self._value, self
+            )
+            if self._cbhdl is None:
+                raise RuntimeError(f"Unable set up {self!s} Trigger")
+        super()._prime(callback)
+
+    def __repr__(self) -> str:
+        if self._value is None:
+            return f"{type(self).__qualname__}({self.signal!r}, mask={self._mask!r})"
+        return f"{type(self).__qualname__}({self.signal!r}, mask={self._mask!r}, value={self._value!r})"
+
+
+class AnyValueChange(GPITrigger):
+    """Fires when any of *signals* change value.
+
+    A value change callback is registered on each signal once and kept for as long as it is watched,
+    so awaiting this repeatedly is much cheaper than awaiting :class:`First`
+    of the :class:`ValueChange` of every signal, which registers and removes all of them on each wake.
+    The changes are collected in the simulator and the trigger fires once,
+    in the ReadWrite phase of the time step in which they happened.
+    :attr:`changed` then lists the signals which changed.
+
+    Signals can be added and removed with :meth:`add` and :meth:`remove`
+    without touching the callbacks on the others.
+
+    Args:
+        signals: The signals to watch.
+
+    Raises:
+        TypeError: If a signal is not an object which can change value.
+
+    Usage:
+        >>> irqs = AnyValueChange(*dut.irq)
+        >>> while True:
+        ...     await irqs
+        ...     for irq in irqs.changed:
+        ...         handle(irq)
+
+    .. versionadded:: 2.1
+    """
+
+    def __init__(
+        self, *signals: "cocotb.handle._NonIndexableValueObjectBase[Any, Any]"
+    ) -> None:
+        super().__init__()
+        self._group: Optional[simulator.gpi_cb_group] = None
+        # Member identifier of each signal, once the group exists
+        self._members: Dict[
+            "cocotb.handle._NonIndexableValueObjectBase[Any, Any]", Optional[int]
+        ] = {}
+        self._signals: Dict[
+            int, "cocotb.handle._NonIndexableValueObjectBase[Any, Any]"
+        ] = {}
+        for signal in signals:
+            self.add(signal)
+
+    @property
+    def signals(
+        self,
+    ) -> Tuple["cocotb.handle._NonIndexableValueObjectBase[Any, Any]", ...]:
+        """The signals being watched."""
+        return tuple(self._members)
+
+    @property
+    def changed(
+        self,
+    ) -> List["cocotb.handle._NonIndexableValueObjectBase[Any, Any]"]:
+        """The signals which changed before the trigger last fired, in the order they changed."""
+        if self._group is None:
+            return []
+        signals = self._signals
+        return [signals[m] for m in self._group.changed() if m in signals]
+
+    def add(
+        self, signal: "cocotb.handle._NonIndexableValueObjectBase[Any, Any]"
+    ) -> None:
+        """Start watching *signal*.
+
+        Raises:
+            TypeError: If *signal* is not an object which can change value.
+        """
+        if not isinstance(signal, cocotb.handle._NonIndexableValueObjectBase):
+            raise TypeError(
+                f"{type(self).__qualname__} requires simulation objects derived from ValueObjectBase. "
+                f"Got {signal!r} of type {type(signal).__qualname__}"
+            )
+        if signal in self._members:
+            return
+        self._members[signal] = None
+        if self._group is not None:
+            self._register(signal, self._group)
+
+    def remove(
+        self, signal: "cocotb.handle._NonIndexableValueObjectBase[Any, Any]"
+    ) -> None:
+        """Stop watching *signal*.
+
+        Raises:
+            ValueError: If *signal* isn't being watched.
+        """
+        try:
+            member = self._members.pop(signal)
+        except KeyError:
+            raise ValueError(f"{signal!r} isn't watched by {self!r}") from None
+        if self._group is not None and member is not None:
+            del self._signals[member]
+            self._group.remove(member)
+
+    def _register(
+        self,
+        signal: "cocotb.handle._NonIndexableValueObjectBase[Any, Any]",
+        group: simulator.gpi_cb_group,
+    ) -> None:
+        member = group.add(signal._handle)
+        self._members[signal] = member
+        self._signals[member] = signal
+
+    def _prime(self, callback: Callable[["Self"], None]) -> None:
+        if self._group is None:
+            self._group = simulator.create_value_change_group()
+            for signal in self._members:
+                self._register(signal, self._group)
+        self._group.arm(callback, self)
+        super()._prime(callback)
+
+    def _unprime(self) -> None:
+        if self._group is not None:
+            self._group.disarm()
+        return super()._unprime()
+
+    def __repr__(self) -> str:
+        return f"{type(self).__qualname__}({', '.join(map(repr, self._members))})"
+
+
 class Edge(ValueChange):
     """Fires on any value change of *signal*.
 
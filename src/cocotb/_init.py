@@ -103,6 +103,10 @@ def run_regression(_: object) -> None:
 
     # setup global scheduler system
     cocotb._scheduler_inst = Scheduler()
+    if bool(int(os.environ.get("COCOTB_BATCH_CALLBACKS", "0"))):
+        cocotb.simulator.set_callback_batching(
+            cocotb._scheduler_inst._sim_react_batch
+        )
 
     # start Regression Manager
     log.info("Running tests")
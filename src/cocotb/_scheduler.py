@@ -10,7 +10,7 @@ import logging
 import threading
 from bdb import BdbQuit
 from collections import OrderedDict
-from typing import Any, Callable, Coroutine, Dict, List, TypeVar, Union
+from typing import Any, Callable, Coroutine, Dict, List, Tuple, TypeVar, Union
 
 import cocotb
 import cocotb._gpi_triggers
@@ -145,6 +145,30 @@ class Scheduler:
             self._react(trigger)
             self._event_loop()
 
+    def _sim_react_batch(
+        self, callbacks: List[Tuple[Callable[..., object], Tuple[Any, ...]]]
+    ) -> None:
+        """Called with the callbacks which fired in one dispatch of the simulator.
+
+        Used instead of :meth:`_sim_react` when :envvar:`COCOTB_BATCH_CALLBACKS` is set.
+        All the triggers which fired are reacted to
+        before the event loop runs once for all of them.
+        """
+        with profiling_context:
+            for func, args in callbacks:
+                if func != self._sim_react:
+                    func(*args)
+                    continue
+                trigger = args[0]
+                cocotb._gpi_triggers._current_gpi_trigger = trigger
+
+                # apply inertial writes if ReadWrite
+                if trigger is self._read_write:
+                    cocotb.handle._apply_scheduled_writes()
+
+                self._react(trigger)
+            self._event_loop()
+
     def _react(self, trigger: Trigger) -> None:
         """Called when a :class:`~cocotb.triggers.Trigger` fires.
 
@@ -8,6 +8,7 @@ import enum
 import logging
 import os
 import re
+import weakref
 from abc import ABC, abstractmethod
 from functools import lru_cache
 from logging import Logger
@@ -16,6 +17,7 @@ from typing import (
     Callable,
     Dict,
     Generic,
+    Hashable,
     Iterable,
     Iterator,
     NoReturn,
@@ -114,13 +116,18 @@ class SimHandleBase(ABC):
         :meta public:
         """
 
+    @cached_property
+    def _info(self) -> simulator.gpi_object_info:
+        # all the object properties, fetched from the GPI in one call
+        return self._handle.get_info()
+
     @cached_property
     def _name(self) -> str:
         """The name of an object.
 
         :meta public:
         """
-        return self._handle.get_name_string()
+        return self._info.name
 
     @cached_property
     def _type(self) -> str:
@@ -128,7 +135,7 @@ class SimHandleBase(ABC):
 
         :meta public:
         """
-        return self._handle.get_type_string()
+        return self._info.type_string
 
     @cached_property
     def _log(self) -> Logger:
@@ -144,7 +151,7 @@ class SimHandleBase(ABC):
 
         :meta public:
         """
-        return self._handle.get_definition_name()
+        return self._info.definition_name
 
     @cached_property
     def _def_file(self) -> str:
@@ -156,7 +163,7 @@ class SimHandleBase(ABC):
 
         :meta public:
         """
-        return self._handle.get_definition_file()
+        return self._info.definition_file
 
     def __hash__(self) -> int:
         return hash(self._handle)
@@ -164,7 +171,8 @@ class SimHandleBase(ABC):
     def __eq__(self, other: object) -> bool:
         if not isinstance(other, SimHandleBase):
             return NotImplemented
-        return self._handle == other._handle
+        # there is only one gpi_sim_hdl per simulator object
+        return self._handle is other._handle
 
     def __repr__(self) -> str:
         desc = self._path
@@ -188,7 +196,7 @@ class _RangeableObjectMixin(SimHandleBase):
     @cached_property
     def range(self) -> Range:
         """Return a :class:`~cocotb.types.Range` over the indexes of the array/vector."""
-        left, right, direction = self._handle.get_range()
+        left, right, direction = self._info.range
         if direction == simulator.RANGE_NO_DIR:
             raise RuntimeError("Expected range to have a direction but got none!")
         return Range(left, "to" if direction == simulator.RANGE_UP else "downto", right)
@@ -761,10 +769,12 @@ class _OldImmediate(Generic[_ValueT]):
 
 _trust_inertial = bool(int(os.environ.get("COCOTB_TRUST_INERTIAL_WRITES", "0")))
 
-# A dictionary of pending (write_func, args), keyed by handle.
+# A dictionary of pending (write_func, args), keyed by handle, by handle and
+# first index for writes to a part of an array, or by handle and "slices" for
+# the slices of a logic array, which are merged into one write.
 # Writes are applied oldest to newest (least recently used).
 # Only the last scheduled write to a particular handle in a timestep is performed.
-_write_calls: "dict[ValueObjectBase[Any, Any], Tuple[Callable[[int, Any], None], _GPISetAction, Any]]" = insertion_ordered_dict()
+_write_calls: "dict[Hashable, Tuple[Callable[[int, Any], None], _GPISetAction, Any]]" = insertion_ordered_dict()
 
 _write_task: Union[Task[None], None] = None
 
@@ -804,7 +814,7 @@ def _apply_scheduled_writes() -> None:
 if _trust_inertial:
 
     def _schedule_write(
-        handle: "ValueObjectBase[Any, Any]",
+        handle: Hashable,
         write_func: Callable[[int, _ValueT], None],
         action: _GPISetAction,
         value: _ValueT,
@@ -814,7 +824,7 @@ if _trust_inertial:
 else:
 
     def _schedule_write(
-        handle: "ValueObjectBase[Any, Any]",
+        handle: Hashable,
         write_func: Callable[[int, _ValueT], None],
         action: _GPISetAction,
         value: _ValueT,
@@ -958,7 +968,7 @@ class ValueObjectBase(SimHandleBase, Generic[ValueGetT, ValueSetT]):
     @cached_property
     def is_const(self) -> bool:
         """``True`` if the simulator object is immutable, e.g. a Verilog parameter or VHDL constant or generic."""
-        return self._handle.get_const()
+        return self._info.const
 
     @abstractmethod
     def _set_value(
@@ -1089,6 +1099,106 @@ class ArrayObject(
         for elem, self_idx in zip(value, self.range):
             self[self_idx]._set_value(elem, action)
 
+    @cached_property
+    def _elem_bytes(self) -> int:
+        width = self._handle.get_array_element_width()
+        if width < 0:
+            raise TypeError(f"Elements of {self._path} are not logic or real signals")
+        return (width + 7) // 8
+
+    @cached_property
+    def _elem_format(self) -> int:
+        if isinstance(self[self.range.left], RealObject):
+            return simulator.ARRAY_REAL
+        return simulator.ARRAY_UINT
+
+    def _buffer_span(self, buffer: Any, start: Optional[int]) -> Tuple[int, int]:
+        """Return the first index and number of elements covered by *buffer*."""
+        r = self.range
+        if start is None:
+            start = r.left
+        try:
+            offset = r.to_range().index(start)
+        except ValueError:
+            raise IndexError(f"{self._path} contains no object at index {start}")
+        count = memoryview(buffer).nbytes // self._elem_bytes
+        return start, min(count, len(r) - offset)
+
+    def read_into(self, buffer: Any, start: Optional[int] = None) -> int:
+        """Read consecutive elements into a writable buffer in one call.
+
+        Elements are read from index *start*, the left bound by default,
+        in the direction of the range until *buffer* is full or the array ends.
+        Each element takes ``(width + 7) // 8`` bytes of *buffer*, least significant byte first.
+        Bits which are not ``0`` or ``1`` are read as ``0``.
+        Elements of arrays of reals are read as native ``float64`` values,
+        e.g. into an ``array.array("d")`` or a NumPy array.
+
+        This is much faster than reading the elements one by one,
+        as no handle is created for each element.
+
+        .. code-block:: python
+
+            image = bytearray(len(dut.mem) * 8)  # reg [63:0] mem [...]
+            dut.mem.read_into(image)
+
+        Args:
+            buffer: Any object supporting the writable buffer protocol, e.g. a :class:`bytearray`.
+            start: Index of the first element to read.
+
+        Returns:
+            The number of elements read.
+
+        Raises:
+            TypeError: If the elements of the array are not logic or real signals.
+            IndexError: If *start* is not in the range of the array.
+
+        .. versionadded:: 2.1
+        """
+        first, count = self._buffer_span(buffer, start)
+        self._handle.read_array(first, count, self._elem_format, buffer)
+        return count
+
+    def write_from(self, buffer: Any, start: Optional[int] = None) -> int:
+        """Deposit consecutive elements from a buffer in one call.
+
+        The counterpart of :meth:`read_into`:
+        elements are written from index *start*, the left bound by default,
+        in the direction of the range until *buffer* is used up or the array ends.
+
+        .. code-block:: python
+
+            dut.mem.write_from(Path("firmware.bin").read_bytes())
+
+        Args:
+            buffer: Any object supporting the buffer protocol, e.g. :class:`bytes`.
+                A trailing partial element is ignored.
+            start: Index of the first element to write.
+
+        Returns:
+            The number of elements written.
+
+        Raises:
+            TypeError: If the elements of the array are not logic or real signals,
+                or if the simulation object is immutable.
+            IndexError: If *start* is not in the range of the array.
+
+        .. versionadded:: 2.1
+        """
+        if isinstance(current_gpi_trigger(), ReadOnly):
+            raise RuntimeError("Attempting settings a value during the ReadOnly phase.")
+        if self.is_const:
+            raise TypeError("Attempted setting an immutable object")
+        first, count = self._buffer_span(buffer, start)
+        data = bytes(memoryview(buffer).cast("B")[: count * self._elem_bytes])
+        elem_format = self._elem_format
+
+        def write(action: int, data: bytes) -> None:
+            self._handle.write_array(action, first, count, elem_format, data)
+
+        _schedule_write((self, first), write, _GPISetAction.DEPOSIT, data)
+        return count
+
     def __getitem__(self, index: int) -> ChildObjectT:
         if isinstance(index, slice):
             raise TypeError("Slicing is not supported")
@@ -1327,6 +1437,116 @@ class LogicArrayObject(
             else False,
         )
 
+    def _slice_width(self, left: int, right: int) -> int:
+        r = self.range.to_range()
+        try:
+            width = r.index(right) - r.index(left) + 1
+        except ValueError:
+            width = 0
+        if width < 1 or len(self.range) != len(self):
+            raise IndexError(f"Slice {left} to {right} is out of range of {self._path}")
+        return width
+
+    def get_slice(self, left: int, right: int) -> LogicArray:
+        """Return the value of the bits *left* to *right* as a :class:`.LogicArray`.
+
+        Only the bits of the slice are fetched from the simulator.
+
+        .. code-block:: python
+
+            field = dut.csr.get_slice(47, 40)
+
+        Raises:
+            IndexError: If the slice is not in the range of the simulation object,
+                in the same direction.
+
+        .. versionadded:: 2.1
+        """
+        self._slice_width(left, right)
+        binstr = self._handle.get_signal_slice(left, right)
+        return LogicArray(binstr, Range(left, self.direction, right))
+
+    def set_slice(self, left: int, right: int, value: Union[LogicArray, int, str]) -> None:
+        """Deposit a value on the bits *left* to *right*, keeping the other bits.
+
+        The bits are written on their own where the simulator allows it.
+        Elsewhere, e.g. on Questa with the FLI, the whole value is read, merged and written back.
+        Slices of the same object which are set before the next :class:`~cocotb.triggers.ReadWrite` phase
+        are merged into one write, so they all take effect.
+        With the fallback, only the last of several slices set during the same
+        :class:`~cocotb.triggers.ReadWrite` phase takes effect, as the simulator doesn't show
+        a deposit to a read until the next delta cycle.
+
+        .. code-block:: python
+
+            dut.csr.set_slice(47, 40, 0xA5)
+
+        Args:
+            left: Index of the leftmost bit of the slice.
+            right: Index of the rightmost bit of the slice.
+            value: The value of the slice.
+                An :class:`int` may be signed or unsigned.
+
+        Raises:
+            IndexError: If the slice is not in the range of the simulation object,
+                in the same direction.
+            TypeError: If *value* is of an unsupported type,
+                or if the simulation object is immutable.
+            ValueError: If *value* doesn't fit in the slice.
+
+        .. versionadded:: 2.1
+        """
+        if isinstance(current_gpi_trigger(), ReadOnly):
+            raise RuntimeError("Attempting settings a value during the ReadOnly phase.")
+        if self.is_const:
+            raise TypeError("Attempted setting an immutable object")
+        width = self._slice_width(left, right)
+
+        value_: str
+        if isinstance(value, int):
+            min_val, max_val = _value_limits(width, _Limits.VECTOR_NBIT)
+            if not min_val <= value <= max_val:
+                raise ValueError(
+                    f"Int value ({value!r}) out of range for assignment of {width!r}-bit slice"
+                )
+            bits = Range(width - 1, "downto", 0)
+            if value < 0:
+                value_ = str(LogicArray.from_signed(value, bits))
+            else:
+                value_ = str(LogicArray.from_unsigned(value, bits))
+        elif isinstance(value, (str, LogicArray)):
+            value_ = str(LogicArray(value) if isinstance(value, str) else value)
+            if len(value_) != width:
+                raise ValueError(
+                    f"cannot assign value of length {len(value_)} to slice of length {width}"
+                )
+        else:
+            raise TypeError(
+                f"Unsupported type for value assignment: {type(value)} ({value!r})"
+            )
+
+        key = (self, "slices")
+        pending = _write_calls.get(key)
+        slices = [(left, right, value_)]
+        if pending is not None:
+            slices = pending[2] + slices
+        _schedule_write(key, self._write_slices, _GPISetAction.DEPOSIT, slices)
+
+    def _write_slices(self, action: int, slices: "list[Tuple[int, int, str]]") -> None:
+        if len(slices) == 1:
+            self._handle.set_signal_slice(action, *slices[0])
+            return
+        # Write one slice spanning all of them, as the simulator may not show
+        # the first write to the read of the second
+        r = self.range.to_range()
+        first = min(r.index(left) for left, _, _ in slices)
+        last = max(r.index(right) for _, right, _ in slices)
+        bits = list(self._handle.get_signal_slice(r[first], r[last]))
+        for left, _, value in slices:
+            start = r.index(left) - first
+            bits[start : start + len(value)] = value
+        self._handle.set_signal_slice(action, r[first], r[last], "".join(bits))
+
     def set(
         self,
         value: Union[
@@ -1381,12 +1601,13 @@ class LogicArrayObject(
 
     @cached_property
     def _len(self) -> int:
-        return self._handle.get_num_elems()
+        return self._info.num_elems
 
     def __getitem__(self, _: object) -> NoReturn:
         raise TypeError(
             "Packed objects, either arrays or structs, cannot be indexed.\n"
-            "Try instead reading the whole value and slicing: `t = handle.value; t[0:3]`.\n"
+            "Try instead reading the whole value and slicing: `t = handle.value; t[0:3]`,\n"
+            "or accessing a slice with `handle.get_slice(3, 0)` and `handle.set_slice(3, 0, value)`.\n"
             "If you need to use an element in an Edge Trigger, consider making the array or struct unpacked.\n"
             "Alternatively, use `ValueChange` on the whole object and check the bit(s) you care about for changes afterwards."
         )
@@ -1698,10 +1919,8 @@ _ConcreteHandleTypes = Union[
 ]
 
 
-_handle2obj: Dict[
-    simulator.gpi_sim_hdl,
-    _ConcreteHandleTypes,
-] = {}
+# Weak, so objects which are no longer referenced release their GPI handle
+_handle2obj: "weakref.WeakValueDictionary[simulator.gpi_sim_hdl, _ConcreteHandleTypes]" = weakref.WeakValueDictionary()
 
 _type2cls: Dict[int, Type[_ConcreteHandleTypes]] = {
     simulator.MODULE: HierarchyObject,
@@ -1742,11 +1961,13 @@ def _make_sim_object(
     except KeyError:
         pass
 
-    t = handle.get_type()
+    info = handle.get_info()
+    t = info.type
     if t not in _type2cls:
         raise NotImplementedError(
-            f"Couldn't find a matching object for GPI type {handle.get_type_string()}({t}) (path={path})"
+            f"Couldn't find a matching object for GPI type {info.type_string}({t}) (path={path})"
         )
     obj = _type2cls[t](handle, path)
+    obj.__dict__["_info"] = info
     _handle2obj[handle] = obj
     return obj
@@ -145,6 +145,36 @@ def _init() -> None:
     # Initialize PyGPI logging
     simulator.initialize_logger(_log_from_c, logging.getLogger)
 
+    # PyGPI caches the effective level of each logger it logs to so filtered
+    # messages never reach Python. The logging manager clears its own level
+    # caches on every setLevel() and disable(), so use that to invalidate ours.
+    manager = logging.Logger.manager
+    if hasattr(manager, "_clear_cache"):
+        old_clear_cache = manager._clear_cache
+
+        @wraps(old_clear_cache)
+        def _clear_cache() -> None:
+            old_clear_cache()
+            simulator.clear_logger_level_cache()
+
+        manager._clear_cache = _clear_cache  # type: ignore[method-assign]
+    else:  # Python 3.6 has no level caches of its own
+        old_logger_setLevel = logging.Logger.setLevel
+        old_disable = logging.disable
+
+        @wraps(old_logger_setLevel)
+        def logger_setLevel(self: logging.Logger, level: Union[int, str]) -> None:
+            old_logger_setLevel(self, level)
+            simulator.clear_logger_level_cache()
+
+        @wraps(old_disable)
+        def disable(level: int = logging.CRITICAL) -> None:
+            old_disable(level)
+            simulator.clear_logger_level_cache()
+
+        logging.Logger.setLevel = logger_setLevel  # type: ignore[method-assign]
+        logging.disable = disable
+
     # Set "cocotb" and "gpi" logger based on environment variables
     def set_level(logger_name: str, envvar: str) -> None:
         log_level = os.environ.get(envvar)
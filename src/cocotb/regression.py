@@ -11,17 +11,23 @@ import hashlib
 import inspect
 import logging
 import os
+import pickle
 import random
 import re
+import select
+import sys
 import time
 import warnings
+import xml.etree.ElementTree as ET
 from enum import auto
 from importlib import import_module
 from typing import (
     TYPE_CHECKING,
     Callable,
     Coroutine,
+    Dict,
     List,
+    Tuple,
     Union,
 )
 
@@ -57,6 +63,7 @@ __all__ = (
     "SimFailure",
     "Test",
     "TestFactory",
+    "fork_checkpoint",
 )
 
 # Set __module__ on re-exports
@@ -77,6 +84,32 @@ class SimFailure(BaseException):
 _logger = logging.getLogger(__name__)
 
 
+def fork_checkpoint(jobs: Union[int, None] = None) -> None:
+    """Run each remaining test in its own fork of the simulation.
+
+    Once the current test ends, the simulation process is forked once for every
+    remaining test, so each of them starts from the state the current test left
+    the design in rather than from where the previous test ended.
+    This lets a long reset and initialization sequence be run once and shared.
+    The results of the forked tests are gathered and reported as usual.
+
+    This requires a simulator which supports forking, currently Verilator with
+    :make:var:`VERILATOR_FORK_SERVER` set.
+    Otherwise the remaining tests run in the normal way.
+
+    Args:
+        jobs: How many forked tests may run at the same time.
+            Defaults to the number of CPUs.
+
+    .. versionadded:: 2.1
+    """
+    if jobs is None:
+        jobs = os.cpu_count() or 1
+    if jobs < 1:
+        raise ValueError("jobs must be at least 1")
+    cocotb._regression_manager._fork_jobs = jobs
+
+
 def _format_doc(docstring: Union[str, None]) -> str:
     if docstring is None:
         return ""
@@ -166,6 +199,10 @@ class RegressionManager:
         self._mode = RegressionMode.REGRESSION
         self._included: List[bool]
         self._sim_failure: Union[Error[None], None] = None
+        self._fork_jobs: Union[int, None] = None
+        self._fork_results_fd: Union[int, None] = None
+        self._fork_first_result: int
+        self._fork_first_testcase: int
 
         # Setup XUnit
         ###################
@@ -330,6 +367,9 @@ class RegressionManager:
         and by :meth:`_fail_regression` to shutdown the regression when a simulation failure occurs.
         """
 
+        if self._fork_jobs is not None and self._sim_failure is None:
+            return self._execute_forked(self._fork_jobs)
+
         while self._test_queue:
             self._test = self._test_queue.pop(0)
             included = self._included.pop(0)
@@ -416,11 +456,15 @@ class RegressionManager:
         # stop the write scheduler
         cocotb.handle._stop_write_scheduler()
 
-        # Write out final log messages
-        self._log_test_summary()
+        if self._fork_results_fd is not None:
+            # Forked child, hand the results to the parent to report
+            self._send_fork_results(self._fork_results_fd)
+        else:
+            # Write out final log messages
+            self._log_test_summary()
 
-        # Generate output reports
-        self.xunit.write()
+            # Generate output reports
+            self.xunit.write()
 
         # TODO refactor initialization and finalization into their own module
         # to prevent circular imports requiring local imports
@@ -431,6 +475,128 @@ class RegressionManager:
         # Setup simulator finalization
         simulator.stop_simulator()
 
+    def _execute_forked(self, jobs: int) -> None:
+        """Called by :meth:`_execute` to run the remaining tests in forked simulations.
+
+        Requested with :func:`fork_checkpoint`.
+        The parent waits for the children and merges their results.
+        Each child runs a single test and returns to :meth:`_execute`.
+        """
+        self._fork_jobs = None
+
+        # record tests which won't run in the parent, the rest get a child each
+        pending: List[Test] = []
+        while self._test_queue:
+            self._test = self._test_queue.pop(0)
+            included = self._included.pop(0)
+            if not included:
+                self._record_test_excluded()
+            elif self._test.skip and self._mode != RegressionMode.TESTCASE:
+                self._record_test_skipped()
+            else:
+                pending.append(self._test)
+
+        # read end of the results pipe -> (pid, test, data read so far)
+        running: Dict[int, Tuple[int, Test, List[bytes]]] = {}
+        forked = 0
+        while pending or running:
+            while pending and len(running) < jobs:
+                test = pending[0]
+                read_fd, write_fd = os.pipe()
+                sys.stdout.flush()
+                sys.stderr.flush()
+                try:
+                    pid = simulator.fork()
+                except RuntimeError:
+                    os.close(read_fd)
+                    os.close(write_fd)
+                    if running:
+                        break
+                    self.log.warning(
+                        "Simulator does not support forking, running the remaining tests normally"
+                    )
+                    self._test_queue = pending
+                    self._included = [True] * len(pending)
+                    return self._execute()
+
+                if pid == 0:
+                    os.close(read_fd)
+                    for fd in running:
+                        os.close(fd)
+                    self._fork_results_fd = write_fd
+                    self._fork_first_result = len(self._test_results)
+                    self._fork_first_testcase = len(self.xunit.last_testsuite)
+                    self._test_queue = [test]
+                    self._included = [True]
+                    # keep the (n/total) test counts of the children in order
+                    self.count += forked
+                    return self._execute()
+
+                os.close(write_fd)
+                running[read_fd] = (pid, test, [])
+                pending.pop(0)
+                forked += 1
+
+            readable, _, _ = select.select(list(running), [], [])
+            for fd in readable:
+                data = os.read(fd, 65536)
+                if data:
+                    running[fd][2].append(data)
+                    continue
+                pid, test, chunks = running.pop(fd)
+                os.close(fd)
+                os.waitpid(pid, 0)
+                self._merge_fork_results(test, b"".join(chunks))
+
+        return self._execute()
+
+    def _send_fork_results(self, fd: int) -> None:
+        """Called by :meth:`_tear_down` in a forked child to send its results to the parent."""
+        testcases = list(self.xunit.last_testsuite)[self._fork_first_testcase :]
+        results = self._test_results[self._fork_first_result :]
+        payload = pickle.dumps(
+            {
+                "testcases": [ET.tostring(testcase) for testcase in testcases],
+                "results": [
+                    (r.test_fullname, r.passed, r.wall_time_s, r.sim_time_ns)
+                    for r in results
+                ],
+                "passed": sum(1 for r in results if r.passed),
+                "failures": sum(1 for r in results if r.passed is False),
+            }
+        )
+        with os.fdopen(fd, "wb") as f:
+            f.write(payload)
+
+    def _merge_fork_results(self, test: Test, data: bytes) -> None:
+        """Called by :meth:`_execute_forked` to record the results sent by a child."""
+        try:
+            results = pickle.loads(data)
+        except Exception:
+            self._test = test
+            self._record_test_failed(
+                wall_time_s=0,
+                sim_time_ns=0,
+                result=SimFailure("Forked simulation ended without results"),
+                msg="forked simulation ended without results",
+            )
+            return
+
+        for testcase in results["testcases"]:
+            self.xunit.last_testsuite.append(ET.fromstring(testcase))
+        for test_fullname, passed, wall_time_s, sim_time_ns in results["results"]:
+            self._test_results.append(
+                _TestResults(
+                    test_fullname=test_fullname,
+                    passed=passed,
+                    wall_time_s=wall_time_s,
+                    sim_time_ns=sim_time_ns,
+                )
+            )
+        self.passed += results["passed"]
+        self.failures += results["failures"]
+        self.count += len(results["results"])
+
     def _test_complete(self) -> None:
         """Callback given to the test to be called when the test finished."""
 
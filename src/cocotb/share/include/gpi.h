@@ -57,9 +57,11 @@ imitate a callback.
 class GpiObjHdl;
 class GpiCbHdl;
 class GpiIterator;
+class GpiCbGroup;
 typedef GpiObjHdl *gpi_sim_hdl;
 typedef GpiCbHdl *gpi_cb_hdl;
 typedef GpiIterator *gpi_iterator_hdl;
+typedef GpiCbGroup *gpi_cb_group_hdl;
 #else
 /* In C, we declare some incomplete struct types that we never complete.
  * The names of these are irrelevant, but for simplicity they match the C++
@@ -68,9 +70,11 @@ typedef GpiIterator *gpi_iterator_hdl;
 struct GpiObjHdl;
 struct GpiCbHdl;
 struct GpiIterator;
+struct GpiCbGroup;
 typedef struct GpiObjHdl *gpi_sim_hdl;
 typedef struct GpiCbHdl *gpi_cb_hdl;
 typedef struct GpiIterator *gpi_iterator_hdl;
+typedef struct GpiCbGroup *gpi_cb_group_hdl;
 #endif
 
 #ifdef __cplusplus
@@ -135,6 +139,130 @@ typedef enum gpi_edge_e {
     GPI_VALUE_CHANGE,
 } gpi_edge;
 
+/** Category of a callback, used to bucket statistics. */
+typedef enum gpi_cb_type_e {
+    GPI_CB_TIMED = 0,
+    GPI_CB_VALUE_CHANGE = 1,
+    GPI_CB_READONLY = 2,
+    GPI_CB_NEXTTIME = 3,
+    GPI_CB_READWRITE = 4,
+    GPI_CB_OTHER = 5,
+    GPI_CB_NUM_TYPES
+} gpi_cb_type;
+
+/** Value format used by a signal read or write, used to bucket statistics. */
+typedef enum gpi_value_format_e {
+    GPI_FORMAT_BINSTR = 0,
+    GPI_FORMAT_STR = 1,
+    GPI_FORMAT_REAL = 2,
+    GPI_FORMAT_INT = 3,
+    GPI_NUM_FORMATS
+} gpi_value_format;
+
+/** Element layout used by gpi_read_array() and gpi_write_array(). */
+typedef enum gpi_array_format_e {
+    /** One character per bit, most significant bit first, not terminated. */
+    GPI_ARRAY_BINSTR = 0,
+    /** `(width + 7) / 8` bytes per element, least significant byte first.
+     * Bits which aren't `0` or `1` read as `0`. */
+    GPI_ARRAY_UINT = 1,
+    /** One `double` per element, for arrays of real values. */
+    GPI_ARRAY_REAL = 2,
+} gpi_array_format;
+
+/** File format of a memory image, see gpi_load_memory(). */
+typedef enum gpi_mem_format_e {
+    /** Raw bytes, each element stored least significant byte first. */
+    GPI_MEM_BIN = 0,
+    /** Text in the format read by Verilog's `$readmemh`. */
+    GPI_MEM_HEX = 1,
+    /** Loadable segments of a little-endian ELF file, at their physical
+     * addresses. */
+    GPI_MEM_ELF = 2,
+} gpi_mem_format;
+
+/** Number of buckets in each callback latency histogram.
+ *
+ * Bucket `i` counts callbacks which took between `2**i` and `2**(i+1)`
+ * nanoseconds, the last bucket catches everything longer.
+ */
+#define GPI_STATS_HIST_BUCKETS 32
+/** Maximum number of counters a simulator harness can register. */
+#define GPI_STATS_MAX_SIM_COUNTERS 16
+
+/** Snapshot of the GPI performance counters. */
+typedef struct gpi_stats_s {
+    /** Number of callbacks run, by type. */
+    uint64_t cb_count[GPI_CB_NUM_TYPES];
+    /** Wall time spent in the user callback function, by type. */
+    uint64_t cb_time_ns[GPI_CB_NUM_TYPES];
+    /** Log2 latency histogram of the user callback function, by type. */
+    uint64_t cb_hist[GPI_CB_NUM_TYPES][GPI_STATS_HIST_BUCKETS];
+    /** Wall time spent in the GPI, including user callback functions. */
+    uint64_t gpi_time_ns;
+    /** Wall time spent in the simulator between callbacks. */
+    uint64_t sim_time_ns;
+    /** Number of signal value reads, by format. */
+    uint64_t reads[GPI_NUM_FORMATS];
+    /** Number of signal value writes, by format. */
+    uint64_t writes[GPI_NUM_FORMATS];
+    /** Number of user callbacks which exceeded the slow callback threshold. */
+    uint64_t slow_cb_count;
+    /** Slow callback threshold, `0` if disabled. */
+    uint64_t slow_cb_threshold_ns;
+    /** Number of signal value reads answered by the ReadOnly value cache. */
+    uint64_t value_cache_hits;
+    /** Number of writes dropped because they wouldn't change the value. */
+    uint64_t elided_writes;
+    /** Number of callbacks delivered in batches, see
+     * gpi_set_callback_batching(). A batch counts once in `cb_count`. */
+    uint64_t batched_cb_count;
+    /** Number of counters registered by the simulator harness. */
+    size_t num_sim_counters;
+    /** Names of the simulator harness counters. */
+    const char *sim_counter_names[GPI_STATS_MAX_SIM_COUNTERS];
+    /** Counters registered with gpi_register_sim_counters(). */
+    uint64_t sim_counters[GPI_STATS_MAX_SIM_COUNTERS];
+} gpi_stats;
+
+/** Memory used by simulation object handles. */
+typedef struct gpi_memory_stats_s {
+    /** Number of live object handles. */
+    size_t num_handles;
+    /** Bytes allocated for the live object handles themselves. */
+    size_t handle_bytes;
+    /** Number of names in the shared string table. */
+    size_t num_strings;
+    /** Bytes used by the strings in the shared string table. */
+    size_t string_bytes;
+} gpi_memory_stats;
+
+/** Metadata of a simulation object, filled by gpi_get_object_info(). */
+typedef struct gpi_object_info_s {
+    /** The @ref gpi_objtype "type" of the object. */
+    gpi_objtype type;
+    /** Direction of the range constraint, see gpi_get_range_dir(). */
+    gpi_range_dir range_dir;
+    /** Left side of the range constraint. */
+    int range_left;
+    /** Right side of the range constraint. */
+    int range_right;
+    /** Number of objects in the collection of the handle. */
+    int num_elems;
+    /** `1` if the object value is constant, `0` otherwise. */
+    int is_const;
+    /** `1` if the object is indexable, `0` otherwise. */
+    int is_indexable;
+    /** Name of the object, see gpi_get_signal_name_str(). */
+    const char *name;
+    /** Type of the object as a string, see gpi_get_signal_type_str(). */
+    const char *type_str;
+    /** Definition name of the object. */
+    const char *definition_name;
+    /** Definition file of the object. */
+    const char *definition_file;
+} gpi_object_info;
+
 /** @defgroup SimIntf Simulator Control and Interrogation
  * These functions are for controlling and querying
  * simulator state and information.
@@ -218,6 +346,21 @@ GPI_EXPORT gpi_sim_hdl gpi_get_handle_by_name(gpi_sim_hdl parent,
 GPI_EXPORT gpi_sim_hdl gpi_get_handle_by_index(gpi_sim_hdl parent,
                                                int32_t index);
 
+/** Release a handle to a simulation object.
+ *
+ * Every handle returned by gpi_get_root_handle(), gpi_get_handle_by_name(),
+ * gpi_get_handle_by_index() and gpi_next() holds a reference to the object,
+ * even if the same handle was returned before. When the last reference is
+ * released, the handle and the simulator resources behind it are freed.
+ * Handles which are never released are freed when the simulation ends.
+ *
+ * Callbacks registered on the object and iterators over it must not outlive
+ * the handle.
+ *
+ * @param gpi_hdl  Handle to release. It must not be used afterwards.
+ */
+GPI_EXPORT void gpi_release_handle(gpi_sim_hdl gpi_hdl);
+
 /** @} */  // End of group ObjQuery
 
 /** @defgroup ObjProps General Object Properties
@@ -261,6 +404,30 @@ GPI_EXPORT int gpi_is_constant(gpi_sim_hdl gpi_hdl);
  */
 GPI_EXPORT int gpi_is_indexable(gpi_sim_hdl gpi_hdl);
 
+/** Get all the properties of a simulation object in one call.
+ *
+ * The strings are owned by the handle and live as long as it does.
+ *
+ * @param gpi_hdl  Handle to the simulation object.
+ * @param info     Location to return the properties.
+ */
+GPI_EXPORT void gpi_get_object_info(gpi_sim_hdl gpi_hdl,
+                                    gpi_object_info *info);
+
+/** Attach a pointer to a simulation object handle.
+ *
+ * Lets the caller find its own object for a handle, for example the object
+ * wrapping it in another language. Handles to the same simulation object are
+ * shared, so there is one pointer per object.
+ *
+ * @param gpi_hdl    Handle to attach the pointer to.
+ * @param user_data  The pointer, or `NULL` to detach it.
+ */
+GPI_EXPORT void gpi_set_user_data(gpi_sim_hdl gpi_hdl, void *user_data);
+
+/** @return The pointer attached with gpi_set_user_data(), or `NULL`. */
+GPI_EXPORT void *gpi_get_user_data(gpi_sim_hdl gpi_hdl);
+
 /** @} */  // End of group ObjProps
 
 /** @defgroup SigProps Signal Object Properties
@@ -342,6 +509,124 @@ GPI_EXPORT void gpi_set_signal_value_binstr(gpi_sim_hdl gpi_hdl,
 GPI_EXPORT void gpi_set_signal_value_str(gpi_sim_hdl gpi_hdl, const char *str,
                                          gpi_set_action action);
 
+// Bulk access to arrays
+
+/** Get the width in bits of the elements of an array.
+ * @param gpi_hdl   Array object handle.
+ * @return          Element width, `64` for real values, or `-1` if the
+ *                  elements aren't signals.
+ */
+GPI_EXPORT int gpi_get_array_element_width(gpi_sim_hdl gpi_hdl);
+
+/** Read consecutive elements of an array in one call.
+ *
+ * Elements are read in the direction of the array's range, without creating an
+ * object handle for each of them.
+ *
+ * @param gpi_hdl   Array object handle.
+ * @param first     Index of the first element to read.
+ * @param count     Number of elements to read.
+ * @param format    Layout of the elements in *buffer*.
+ * @param buffer    Destination, with room for *count* elements of the size
+ *                  given by *format* and gpi_get_array_element_width().
+ * @return          `0` on success, `-1` on failure.
+ */
+GPI_EXPORT int gpi_read_array(gpi_sim_hdl gpi_hdl, int first, int count,
+                              gpi_array_format format, void *buffer);
+
+/** Write consecutive elements of an array in one call.
+ *
+ * The counterpart of gpi_read_array().
+ *
+ * @param gpi_hdl   Array object handle.
+ * @param first     Index of the first element to write.
+ * @param count     Number of elements to write.
+ * @param format    Layout of the elements in *buffer*.
+ * @param buffer    Source of *count* elements.
+ * @param action    Action to use.
+ * @return          `0` on success, `-1` on failure.
+ */
+GPI_EXPORT int gpi_write_array(gpi_sim_hdl gpi_hdl, int first, int count,
+                               gpi_array_format format, const void *buffer,
+                               gpi_set_action action);
+
+// Bit slices of vectors
+
+/** Get the value of a slice of a logic vector as a binary string.
+ *
+ * Only the bits of the slice are converted, see gpi_get_signal_value_binstr().
+ *
+ * @param gpi_hdl   Logic vector object handle.
+ * @param left      Index of the leftmost bit of the slice.
+ * @param right     Index of the rightmost bit of the slice, in the direction
+ *                  of the vector's range from *left*.
+ * @return          Binary string of the slice, valid until the next call, or
+ *                  `NULL` on failure.
+ */
+GPI_EXPORT const char *gpi_get_signal_slice(gpi_sim_hdl gpi_hdl, int left,
+                                            int right);
+
+/** Set the value of a slice of a logic vector from a binary string.
+ *
+ * The other bits of the vector keep their value. Where possible the bits of
+ * the slice are written on their own, otherwise the value of the whole
+ * vector is read and written back.
+ *
+ * @param gpi_hdl   Logic vector object handle.
+ * @param left      Index of the leftmost bit of the slice.
+ * @param right     Index of the rightmost bit of the slice.
+ * @param binstr    Binary string with one character per bit of the slice.
+ * @param action    Action to use.
+ * @return          `0` on success, `-1` on failure.
+ */
+GPI_EXPORT int gpi_set_signal_slice(gpi_sim_hdl gpi_hdl, int left, int right,
+                                    const char *binstr,
+                                    gpi_set_action action);
+
+/** Get the values of several real signals in one call.
+ * @param gpi_hdls  Real object handles.
+ * @param count     Number of handles.
+ * @param values    Destination of *count* values.
+ * @return          `0` on success, `-1` if an object isn't a real signal.
+ */
+GPI_EXPORT int gpi_get_signal_values_real(const gpi_sim_hdl *gpi_hdls,
+                                          int count, double *values);
+
+/** Set the values of several real signals in one call.
+ * @param gpi_hdls  Real object handles.
+ * @param count     Number of handles.
+ * @param values    *count* values to set.
+ * @param action    Action to use.
+ * @return          `0` on success, `-1` if an object isn't a real signal.
+ */
+GPI_EXPORT int gpi_set_signal_values_real(const gpi_sim_hdl *gpi_hdls,
+                                          int count, const double *values,
+                                          gpi_set_action action);
+
+/** Cache signal values read during ReadOnly callbacks.
+ *
+ * Values can't change in the ReadOnly phase, so repeated reads of the same
+ * signal in the same format are answered from a cache which is emptied when
+ * the callback returns and on any write.
+ * The initial setting is taken from the ``GPI_READONLY_VALUE_CACHE``
+ * environment variable.
+ *
+ * @param enable  `true` to enable the cache, `false` to disable it.
+ */
+GPI_EXPORT void gpi_set_readonly_value_cache(bool enable);
+
+/** Drop deposits which wouldn't change the value of a signal.
+ *
+ * The last value deposited on each signal is kept until the signal changes or
+ * is read, and depositing the same value again in the same format doesn't
+ * reach the simulator.
+ * The initial setting is taken from the ``GPI_WRITE_ELISION`` environment
+ * variable.
+ *
+ * @param enable  `true` to enable write elision, `false` to disable it.
+ */
+GPI_EXPORT void gpi_set_write_elision(bool enable);
+
 /** @} */  // End of group SigProps
 
 /** @defgroup HandleIteration Simulation Object Iteration
@@ -399,6 +684,77 @@ GPI_EXPORT gpi_cb_hdl gpi_register_value_change_callback(
     int (*gpi_function)(void *), void *gpi_cb_data, gpi_sim_hdl gpi_hdl,
     gpi_edge edge);
 
+/** Register a value change callback which only watches some bits.
+ *
+ * The callback fires on changes of the bits set to `1` in *mask*. If *value*
+ * is given it only fires when those bits change to the corresponding bits of
+ * *value*. Other changes are filtered out without calling up.
+ *
+ * @param gpi_function  Callback function pointer.
+ * @param gpi_cb_data   Pointer to user data to be passed to callback function.
+ * @param gpi_hdl       Simulation object to monitor for value change.
+ * @param mask          Binary string of the bits to watch, with one character
+ *                      per bit of the value of the object.
+ * @param value         Binary string of the target value, or NULL to fire on
+ *                      any change of the watched bits.
+ * @return              Handle to callback object.
+ */
+GPI_EXPORT gpi_cb_hdl gpi_register_masked_value_change_callback(
+    int (*gpi_function)(void *), void *gpi_cb_data, gpi_sim_hdl gpi_hdl,
+    const char *mask, const char *value);
+
+/** Create a group of value change callbacks on a set of signals.
+ *
+ * A value change callback stays registered on each member for as long as it
+ * is in the group. While the group is armed, changes of its members are
+ * collected and the group fires once in the next ReadWrite phase, normally
+ * once per time step however many members changed. Firing disarms the group.
+ *
+ * @param gpi_function  Callback function pointer, called each time the group
+ *                      fires.
+ * @param gpi_cb_data   Pointer to user data to be passed to callback function.
+ * @return              Handle to the group, which starts empty and disarmed.
+ */
+GPI_EXPORT gpi_cb_group_hdl gpi_create_cb_group(int (*gpi_function)(void *),
+                                                void *gpi_cb_data);
+
+/** Add a signal to a callback group.
+ *
+ * @param group    The group.
+ * @param gpi_hdl  Simulation object to monitor for value change.
+ * @return         Identifier of the member, or `-1` on failure.
+ */
+GPI_EXPORT int gpi_cb_group_add(gpi_cb_group_hdl group, gpi_sim_hdl gpi_hdl);
+
+/** Remove a member from a callback group.
+ *
+ * The identifier may be reused by a later gpi_cb_group_add().
+ *
+ * @param group   The group.
+ * @param member  Identifier returned by gpi_cb_group_add().
+ * @return        `0` on success, `1` if *member* isn't in the group.
+ */
+GPI_EXPORT int gpi_cb_group_remove(gpi_cb_group_hdl group, int member);
+
+/** Start or stop collecting the changes of the members of a callback group.
+ *
+ * Disarming drops the changes collected so far.
+ */
+GPI_EXPORT void gpi_cb_group_set_armed(gpi_cb_group_hdl group, bool armed);
+
+/** Get the members which changed before a callback group last fired.
+ *
+ * @param group    The group.
+ * @param members  Where a pointer to the member identifiers is placed, valid
+ *                 until the group fires again or is changed.
+ * @return         Number of members which changed.
+ */
+GPI_EXPORT size_t gpi_cb_group_get_changed(gpi_cb_group_hdl group,
+                                           const int **members);
+
+/** Destroy a callback group, removing the callbacks on its members. */
+GPI_EXPORT void gpi_destroy_cb_group(gpi_cb_group_hdl group);
+
 /** Register a readonly simulation phase callback.
  *
  * Callback will be called when simulation next enters the readonly phase.
@@ -439,6 +795,34 @@ gpi_register_readwrite_callback(int (*gpi_function)(void *), void *gpi_cb_data);
  */
 GPI_EXPORT int gpi_remove_cb(gpi_cb_hdl cb_hdl);
 
+/** Deliver callbacks in batches.
+ *
+ * Callbacks with the function *cb_func* which fire in the same dispatch of
+ * the simulator harness are collected, and *batch_func* is called once with
+ * the data of all of them when the dispatch ends. Elsewhere callbacks are
+ * called one at a time as usual.
+ *
+ * @param cb_func     Callback function to batch.
+ * @param batch_func  Function called with the data of *count* callbacks, or
+ *                    NULL to stop batching.
+ */
+GPI_EXPORT void gpi_set_callback_batching(
+    int (*cb_func)(void *),
+    int (*batch_func)(void *const *cb_data, size_t count));
+
+/** Start a dispatch of callbacks which can be delivered in one batch.
+ *
+ * Called by simulator harnesses which run many callbacks in a loop, and must
+ * be paired with gpi_end_callback_batch(). Dispatches may be nested.
+ */
+GPI_EXPORT void gpi_begin_callback_batch(void);
+
+/** End a dispatch started with gpi_begin_callback_batch().
+ *
+ * Delivers the callbacks collected since the outermost dispatch started.
+ */
+GPI_EXPORT void gpi_end_callback_batch(void);
+
 /** Retrieve user callback information from callback handle.
  *
  * This function cannot fail.
@@ -452,6 +836,182 @@ GPI_EXPORT void gpi_get_cb_info(gpi_cb_hdl cb_hdl, int (**cb_func)(void *),
 
 /** @} */  // End of group SimCallbacks
 
+/** @defgroup Stats Performance Statistics
+ * These functions are for inspecting the GPI performance counters.
+ * @{
+ */
+
+/** Get a snapshot of the performance counters.
+ *
+ * @param stats  Location to copy the counters to.
+ */
+GPI_EXPORT void gpi_get_stats(gpi_stats *stats);
+
+/** Reset all performance counters to zero.
+ *
+ * The slow callback threshold is left untouched.
+ */
+GPI_EXPORT void gpi_reset_stats(void);
+
+/** Set the slow callback threshold.
+ *
+ * User callbacks taking longer than this are counted and logged.
+ * The initial value is taken from the ``GPI_SLOW_CALLBACK_THRESHOLD``
+ * environment variable, in microseconds.
+ *
+ * @param threshold_ns  Threshold in nanoseconds, `0` to disable.
+ */
+GPI_EXPORT void gpi_set_slow_callback_threshold(uint64_t threshold_ns);
+
+/** Register counters kept by the simulator harness.
+ *
+ * They are reported by gpi_get_stats() and zeroed by gpi_reset_stats().
+ *
+ * @param names   Names of the counters, which must stay valid.
+ * @param values  The counters, which must stay valid.
+ * @param count   Number of counters, at most GPI_STATS_MAX_SIM_COUNTERS.
+ */
+GPI_EXPORT void gpi_register_sim_counters(const char *const *names,
+                                          uint64_t *values, size_t count);
+
+/** Get the memory used by simulation object handles.
+ *
+ * Object names, definition names and files are shared between handles in a
+ * string table, which is included. Memory held by the simulator for the
+ * handles is not.
+ *
+ * @param stats  Location to return the memory usage.
+ */
+GPI_EXPORT void gpi_get_memory_stats(gpi_memory_stats *stats);
+
+/** @} */  // End of group Stats
+
+/** @defgroup Fork Process Forking
+ * These functions let simulators which keep all their state in the simulation
+ * process be forked, so several children can continue from the same state.
+ * @{
+ */
+
+/** Allow the simulation process to be forked with gpi_fork().
+ *
+ * Called by simulator harnesses which support forking.
+ *
+ * @param prepare  Called before forking, e.g. to flush output files.
+ *                 May be `NULL`.
+ * @param child    Called in the child after forking, e.g. to reopen output
+ *                 files under a new name. May be `NULL`.
+ */
+GPI_EXPORT void gpi_enable_fork(void (*prepare)(void), void (*child)(void));
+
+/** Fork the simulation process.
+ *
+ * @return The PID of the child in the parent, `0` in the child, or `-1` if
+ *         forking is unsupported or failed.
+ */
+GPI_EXPORT long gpi_fork(void);
+
+/** @} */  // End of group Fork
+
+/** @defgroup Checkpoint Simulation Checkpoints
+ * These functions let simulators which can serialize their state save it on
+ * request.
+ * @{
+ */
+
+/** Allow checkpoints to be saved with gpi_checkpoint_save().
+ *
+ * Called by simulator harnesses which support checkpoints.
+ *
+ * @param save  Requests a checkpoint to be saved to the given file, returning
+ *              non-zero if that's not possible, e.g. if the file can't be
+ *              created.
+ */
+GPI_EXPORT void gpi_enable_checkpoint(int (*save)(const char *filename));
+
+/** Request the simulation state to be saved to a file.
+ *
+ * The checkpoint is taken at the end of the current time step, once all
+ * writes have been applied.
+ *
+ * @param filename  File to save the checkpoint to.
+ * @return `0` on success, or non-zero if checkpoints are unsupported or the
+ *         request was refused.
+ */
+GPI_EXPORT int gpi_checkpoint_save(const char *filename);
+
+/** @} */  // End of group Checkpoint
+
+/** @defgroup Waveforms Waveform Control
+ * These functions let simulators which dump waveforms from the harness start
+ * and stop dumping on request.
+ * @{
+ */
+
+/** Allow waveform dumping to be controlled with gpi_set_waveform_dumping().
+ *
+ * Called by simulator harnesses which support it.
+ *
+ * @param set_dumping  Starts or stops dumping, returning non-zero if that's not
+ *                     possible.
+ */
+GPI_EXPORT void gpi_enable_waveform_control(int (*set_dumping)(bool enable));
+
+/** Start or stop dumping waveforms.
+ *
+ * The change takes effect immediately, so it also decides whether the current
+ * time step is dumped.
+ *
+ * @param enable  `true` to start dumping, `false` to stop.
+ * @return `0` on success, or non-zero if waveform control is unsupported or
+ *         the request was refused.
+ */
+GPI_EXPORT int gpi_set_waveform_dumping(bool enable);
+
+/** @} */  // End of group Waveforms
+
+/** @defgroup MemImage Memory Images
+ * These functions load and save the contents of memories modeled as arrays
+ * without going through the value of each element.
+ * @{
+ */
+
+/** Load a memory image file into an array.
+ *
+ * The file is memory-mapped and written with gpi_write_array(). Addresses
+ * in the image count elements, as in the `@` directives of HEX images. For
+ * BIN and ELF images, whose addresses count bytes, they are divided by the
+ * size of an element, `(width + 7) / 8` bytes. The element at image address
+ * *addr* is written to position `addr + offset` from the left bound of the
+ * array. Elements which aren't in the image keep their value, and the whole
+ * image must fit in the array.
+ *
+ * @param gpi_hdl   Array object handle.
+ * @param path      Image file.
+ * @param format    Format of the image file.
+ * @param offset    Position of the element at image address `0`.
+ * @return          `0` on success, `-1` on failure.
+ */
+GPI_EXPORT int gpi_load_memory(gpi_sim_hdl gpi_hdl, const char *path,
+                               gpi_mem_format format, int64_t offset);
+
+/** Save the contents of an array to a memory image file.
+ *
+ * The counterpart of gpi_load_memory(), which writes all the elements of the
+ * array. ELF images can't be written.
+ *
+ * @param gpi_hdl   Array object handle.
+ * @param path      Image file.
+ * @param format    Format of the image file.
+ * @param offset    Position of the element at image address `0`, used to
+ *                  write the start address of HEX images. Must be `0` for
+ *                  BIN images.
+ * @return          `0` on success, `-1` on failure.
+ */
+GPI_EXPORT int gpi_dump_memory(gpi_sim_hdl gpi_hdl, const char *path,
+                               gpi_mem_format format, int64_t offset);
+
+/** @} */  // End of group MemImage
+
 #ifdef __cplusplus
 }
 #endif
@@ -284,6 +284,36 @@ GPILOG_EXPORT bool gpi_native_logger_filtered(int level);
  */
 GPILOG_EXPORT int gpi_native_logger_set_level(int level);
 
+/** Type of a function returning the current simulation time for log records.
+ *
+ * @param time_ns   Location to return the current simulation time in
+ *                  nanoseconds.
+ * @return `true` if the time is available.
+ */
+typedef bool (*gpi_native_logger_sim_time_ftype)(double *time_ns);
+
+/** Set the function used by the native logger to stamp records with the
+ * current simulation time.
+ *
+ * @param func  Sim time function, or `NULL` to print a placeholder.
+ */
+GPILOG_EXPORT void gpi_native_logger_set_sim_time_func(
+    gpi_native_logger_sim_time_ftype func);
+
+/** Enable or disable asynchronous writing in the native logger.
+ *
+ * When enabled, records are formatted into a ring buffer and written out in
+ * batches by a background thread rather than written and flushed one at a
+ * time. Records are always written out before the process exits.
+ *
+ * @param enable    Whether to write asynchronously.
+ * @return `false` if the asynchronous writer could not be started.
+ */
+GPILOG_EXPORT bool gpi_native_logger_set_async(bool enable);
+
+/** Block until all records buffered by the native logger are written. */
+GPILOG_EXPORT void gpi_native_logger_flush(void);
+
 #ifdef __cplusplus
 }
 #endif
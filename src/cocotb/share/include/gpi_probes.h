@@ -0,0 +1,68 @@
+// Copyright cocotb contributors
+// Licensed under the Revised BSD License, see LICENSE for details.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef COCOTB_GPI_PROBES_H_
+#define COCOTB_GPI_PROBES_H_
+
+/** @file gpi_probes.h
+
+Static tracing probes
+=====================
+
+On Linux, when `<sys/sdt.h>` (from SystemTap) is available at build time,
+cocotb is built with statically defined tracing (SDT / USDT) probes under the
+`cocotb` provider. A disabled probe is a single `nop` instruction, so they are
+always compiled in. Tools such as `perf` and `bpftrace` can attach to them
+without rebuilding or restarting the simulation with special settings, e.g.
+
+    bpftrace -e 'usdt:libcocotbvpi_icarus.vpl:cocotb:vpi_callback
+                 { @reasons[arg0] = count(); }' -p PID
+
+Probes and their arguments:
+
+- `gpi_to_user()`, `gpi_to_simulator()`: control enters / leaves the GPI.
+- `vpi_callback(reason, cb_hdl, sim_time)`,
+  `vpi_callback_return(reason, cb_hdl)`: VPI callback entry and exit.
+- `vhpi_callback(reason, cb_hdl, sim_time)`,
+  `vhpi_callback_return(reason, cb_hdl)`: VHPI callback entry and exit.
+- `fli_callback(cb_hdl)`, `fli_callback_return(cb_hdl)`: FLI callback entry
+  and exit.
+- `python_callback(cb_data)`, `python_callback_return(cb_data, status)`:
+  Python callback function entry and exit.
+- `object_handle(obj_hdl, parent_hdl, name)`: an object handle is handed
+  out, with the handle of the object it was found in, or NULL for the root.
+  Tracers can join the names of the chain of parents to get the full name.
+- `signal_get(sig_hdl, format)`, `signal_set(sig_hdl, format, action)`:
+  signal value access, where `format` is a @ref gpi_value_format. Only the
+  handle is passed, so no name is built when the probe isn't in use.
+
+Define `COCOTB_NO_SDT` to build without probes.
+*/
+
+#if !defined(COCOTB_NO_SDT) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define COCOTB_HAVE_SDT 1
+#endif
+#endif
+
+#ifdef COCOTB_HAVE_SDT
+#define GPI_PROBE0(name) DTRACE_PROBE(cocotb, name)
+#define GPI_PROBE1(name, a) DTRACE_PROBE1(cocotb, name, a)
+#define GPI_PROBE2(name, a, b) DTRACE_PROBE2(cocotb, name, a, b)
+#define GPI_PROBE3(name, a, b, c) DTRACE_PROBE3(cocotb, name, a, b, c)
+#define GPI_PROBE4(name, a, b, c, d) DTRACE_PROBE4(cocotb, name, a, b, c, d)
+#else
+// Arguments are only named in unevaluated sizeof operands so they cost
+// nothing but don't trigger unused variable warnings
+#define GPI_PROBE0(name) (void)0
+#define GPI_PROBE1(name, a) (void)sizeof(a)
+#define GPI_PROBE2(name, a, b) ((void)sizeof(a), (void)sizeof(b))
+#define GPI_PROBE3(name, a, b, c) \
+    ((void)sizeof(a), (void)sizeof(b), (void)sizeof(c))
+#define GPI_PROBE4(name, a, b, c, d) \
+    ((void)sizeof(a), (void)sizeof(b), (void)sizeof(c), (void)sizeof(d))
+#endif
+
+#endif /* COCOTB_GPI_PROBES_H_ */
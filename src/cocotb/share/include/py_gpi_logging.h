@@ -24,6 +24,13 @@ PYGPILOG_EXPORT void py_gpi_logger_initialize(PyObject *handler,
 
 PYGPILOG_EXPORT void py_gpi_logger_finalize();
 
+/** Forget the cached effective levels of Python loggers.
+ *
+ * Must be called with the GIL held whenever a Python logger's level changes,
+ * so messages are not wrongly dropped (or needlessly passed) to Python.
+ */
+PYGPILOG_EXPORT void py_gpi_logger_clear_level_cache();
+
 extern PYGPILOG_EXPORT PyObject *pEventFn;  // This is gross but I don't care
 
 #ifdef __cplusplus
@@ -7,9 +7,14 @@
 
 #include "FliImpl.h"
 #include "_vendor/fli/mti.h"
+#include "cocotb_utils.h"
+#include "gpi_probes.h"
 
 // Main re-entry point for callbacks from simulator
 void handle_fli_callback(void *data) {
+    GPI_PROBE1(fli_callback, data);
+    DEFER(GPI_PROBE1(fli_callback_return, data));
+
     gpi_to_user();
 
     // TODO Add why?
@@ -51,7 +56,7 @@ int FliTimedCbHdl::run() {
     int res = 0;
     if (!m_removed) {
         // Prevent the callback from calling up if it's been removed.
-        res = m_cb_func(m_cb_data);
+        res = call_cb_func();
     }
     // Don't delete, but release back to the appropriate cache to be reused.
     release();
@@ -84,14 +89,14 @@ int FliSignalCbHdl::run() {
             break;
         }
         case GPI_VALUE_CHANGE: {
-            pass = true;
+            pass = !m_filter.active() || m_filter.pass(m_signal);
             break;
         }
     }
 
     int res = 0;
     if (pass) {
-        res = m_cb_func(m_cb_data);
+        res = call_cb_func();
 
         // Don't delete, but desensitize the process from the signal change and
         // release back to the appropriate cache to be reused.
@@ -120,7 +125,7 @@ int FliSimPhaseCbHdl::run() {
     int res = 0;
     if (!m_removed) {
         // Prevent the callback from calling up if it's been removed.
-        res = m_cb_func(m_cb_data);
+        res = call_cb_func();
     }
     // Don't delete, but release back to the appropriate cache to be reused.
     release();
@@ -162,7 +167,7 @@ int FliStartupCbHdl::arm() {
 }
 
 int FliStartupCbHdl::run() {
-    int res = m_cb_func(m_cb_data);
+    int res = call_cb_func();
     delete this;
     return res;
 }
@@ -179,7 +184,7 @@ int FliShutdownCbHdl::arm() {
 }
 
 int FliShutdownCbHdl::run() {
-    int res = m_cb_func(m_cb_data);
+    int res = call_cb_func();
     delete this;
     return res;
 }
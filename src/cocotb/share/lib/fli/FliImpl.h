@@ -91,15 +91,18 @@ class FliSignalCbHdl : public FliProcessCbHdl {
     void set_signal_and_edge(FliSignalObjHdl *signal, gpi_edge edge) noexcept {
         m_signal = signal;
         m_edge = edge;
+        m_filter.clear();
     };
     int arm() override;
     int run() override;
     int remove() override;
     void release() override;
+    GpiValueFilter *get_value_filter() override { return &m_filter; }
 
   private:
     FliSignalObjHdl *m_signal;
     gpi_edge m_edge;
+    GpiValueFilter m_filter;
 };
 
 class FliSimPhaseCbHdl : public FliProcessCbHdl {
@@ -247,10 +250,18 @@ class FliValueObjHdl : public FliSignalObjHdl {
     int initialise(const std::string &name,
                    const std::string &fq_name) override;
 
+    int get_element_width() override;
+    int read_elements(int first, int count, gpi_array_format format,
+                      uint8_t *buffer) override;
+    int write_elements(int first, int count, gpi_array_format format,
+                       const uint8_t *buffer, gpi_set_action action) override;
+
     mtiTypeKindT get_fli_typekind() { return m_fli_type; }
     mtiTypeIdT get_fli_typeid() { return m_val_type; }
 
   protected:
+    bool has_real_elements();
+
     mtiTypeKindT m_fli_type;
     mtiTypeIdT m_val_type;
     char *m_val_buff = nullptr;
@@ -7,6 +7,7 @@
 #include <cmath>
 #include <cstring>
 #include <string>
+#include <vector>
 
 #include "FliImpl.h"
 #include "_vendor/fli/acc_vhdl.h"
@@ -65,10 +66,10 @@ int FliObjHdl::initialise(const std::string &name, const std::string &fq_name) {
     }
 
     str = mti_GetPrimaryName(get_handle<mtiRegionIdT>());
-    if (str != NULL) m_definition_name = str;
+    if (str != NULL) set_definition_name(str);
 
     str = mti_GetRegionSourceName(get_handle<mtiRegionIdT>());
-    if (str != NULL) m_definition_file = str;
+    if (str != NULL) set_definition_file(str);
 
     return GpiObjHdl::initialise(name, fq_name);
 }
@@ -91,18 +92,79 @@ int FliValueObjHdl::initialise(const std::string &name,
     return FliSignalObjHdl::initialise(name, fq_name);
 }
 
+bool FliValueObjHdl::has_real_elements() {
+    return get_type() == GPI_ARRAY &&
+           mti_GetTypeKind(mti_GetArrayElementType(m_val_type)) ==
+               MTI_TYPE_REAL;
+}
+
+int FliValueObjHdl::get_element_width() {
+    if (has_real_elements()) {
+        return 64;
+    }
+    return GpiObjHdl::get_element_width();
+}
+
+// Arrays of reals are read and written as a whole, other arrays go through
+// their elements
+int FliValueObjHdl::read_elements(int first, int count,
+                                  gpi_array_format format, uint8_t *buffer) {
+    if (format != GPI_ARRAY_REAL || !has_real_elements()) {
+        return GpiObjHdl::read_elements(first, count, format, buffer);
+    }
+
+    std::vector<double> values(static_cast<size_t>(m_num_elems));
+    if (m_is_var) {
+        mti_GetArrayVarValue(get_handle<mtiVariableIdT>(), values.data());
+    } else {
+        mti_GetArraySignalValue(get_handle<mtiSignalIdT>(), values.data());
+    }
+    const int offset = m_range_dir == GPI_RANGE_DOWN ? m_range_left - first
+                                                     : first - m_range_left;
+    memcpy(buffer, values.data() + offset,
+           static_cast<size_t>(count) * sizeof(double));
+    return 0;
+}
+
+int FliValueObjHdl::write_elements(int first, int count,
+                                   gpi_array_format format,
+                                   const uint8_t *buffer,
+                                   gpi_set_action action) {
+    if (format != GPI_ARRAY_REAL || !has_real_elements() ||
+        (action != GPI_DEPOSIT && action != GPI_NO_DELAY)) {
+        return GpiObjHdl::write_elements(first, count, format, buffer, action);
+    }
+
+    std::vector<double> values(static_cast<size_t>(m_num_elems));
+    if (m_is_var) {
+        mti_GetArrayVarValue(get_handle<mtiVariableIdT>(), values.data());
+    } else {
+        mti_GetArraySignalValue(get_handle<mtiSignalIdT>(), values.data());
+    }
+    const int offset = m_range_dir == GPI_RANGE_DOWN ? m_range_left - first
+                                                     : first - m_range_left;
+    memcpy(values.data() + offset, buffer,
+           static_cast<size_t>(count) * sizeof(double));
+    if (m_is_var) {
+        mti_SetVarValue(get_handle<mtiVariableIdT>(), (mtiLongT)values.data());
+    } else {
+        mti_SetSignalValue(get_handle<mtiSignalIdT>(), (mtiLongT)values.data());
+    }
+    return 0;
+}
+
 const char *FliValueObjHdl::get_signal_value_binstr() {
     LOG_ERROR(
         "Getting signal/variable value as binstr not supported for %s of type "
         "%d",
-        m_fullname.c_str(), m_type);
+        get_fullname_str(), m_type);
     return NULL;
 }
 
 const char *FliValueObjHdl::get_signal_value_str() {
     LOG_ERROR(
         "Getting signal/variable value as str not supported for %s of type %d",
-        m_fullname.c_str(), m_type);
+        get_fullname_str(), m_type);
     return NULL;
 }
 
@@ -110,14 +172,14 @@ double FliValueObjHdl::get_signal_value_real() {
     LOG_ERROR(
         "Getting signal/variable value as double not supported for %s of type "
         "%d",
-        m_fullname.c_str(), m_type);
+        get_fullname_str(), m_type);
     return -1;
 }
 
 long FliValueObjHdl::get_signal_value_long() {
     LOG_ERROR(
         "Getting signal/variable value as long not supported for %s of type %d",
-        m_fullname.c_str(), m_type);
+        get_fullname_str(), m_type);
     return -1;
 }
 
@@ -125,7 +187,7 @@ int FliValueObjHdl::set_signal_value(int32_t, gpi_set_action) {
     LOG_ERROR(
         "Setting signal/variable value via int32_t not supported for %s of "
         "type %d",
-        m_fullname.c_str(), m_type);
+        get_fullname_str(), m_type);
     return -1;
 }
 
@@ -133,7 +195,7 @@ int FliValueObjHdl::set_signal_value_binstr(std::string &, gpi_set_action) {
     LOG_ERROR(
         "Setting signal/variable value via string not supported for %s of type "
         "%d",
-        m_fullname.c_str(), m_type);
+        get_fullname_str(), m_type);
     return -1;
 }
 
@@ -141,7 +203,7 @@ int FliValueObjHdl::set_signal_value_str(std::string &, gpi_set_action) {
     LOG_ERROR(
         "Setting signal/variable value via string not supported for %s of type "
         "%d",
-        m_fullname.c_str(), m_type);
+        get_fullname_str(), m_type);
     return -1;
 }
 
@@ -149,7 +211,7 @@ int FliValueObjHdl::set_signal_value(double, gpi_set_action) {
     LOG_ERROR(
         "Setting signal/variable value via double not supported for %s of type "
         "%d",
-        m_fullname.c_str(), m_type);
+        get_fullname_str(), m_type);
     return -1;
 }
 
@@ -319,13 +381,13 @@ const char *FliLogicObjHdl::get_signal_value_binstr() {
             }
         } break;
         default:
-            LOG_ERROR("Object type is not 'logic' for %s (%d)", m_name.c_str(),
+            LOG_ERROR("Object type is not 'logic' for %s (%d)", get_name_str(),
                       m_fli_type);
             return NULL;
     }
 
     LOG_DEBUG("Retrieved \"%s\" for value object %s", m_val_buff,
-              m_name.c_str());
+              get_name_str());
 
     return m_val_buff;
 }
@@ -643,7 +705,7 @@ double FliRealObjHdl::get_signal_value_real() {
     }
 
     LOG_DEBUG("Retrieved \"%f\" for value object %s", m_mti_buff[0],
-              m_name.c_str());
+              get_name_str());
 
     return m_mti_buff[0];
 }
@@ -717,7 +779,7 @@ const char *FliStringObjHdl::get_signal_value_str() {
     strncpy(m_val_buff, m_mti_buff, static_cast<size_t>(m_num_elems));
 
     LOG_DEBUG("Retrieved \"%s\" for value object %s", m_val_buff,
-              m_name.c_str());
+              get_name_str());
 
     return m_val_buff;
 }
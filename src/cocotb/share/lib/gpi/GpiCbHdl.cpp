@@ -3,14 +3,126 @@
 // Licensed under the Revised BSD License, see LICENSE for details.
 // SPDX-License-Identifier: BSD-3-Clause
 
+#include <cctype>
+#include <cstring>
+#include <unordered_set>
+
 #include "gpi.h"
 #include "gpi_priv.h"
 
-const char *GpiObjHdl::get_name_str() { return m_name.c_str(); }
+static const std::string unknown_name = "unknown";
+static const std::string empty_name;
+
+static size_t handle_count = 0;
+static size_t handle_bytes = 0;
+static size_t string_bytes = 0;
+
+static std::unordered_set<std::string> &string_table() {
+    // constructed on first use, handles may be created during static init
+    static std::unordered_set<std::string> table;
+    return table;
+}
+
+const std::string *gpi_intern_string(const std::string &str) {
+    auto res = string_table().insert(str);
+    if (res.second) {
+        const std::string &interned = *res.first;
+        const char *data = interned.data();
+        bool inline_data = data >= reinterpret_cast<const char *>(&interned) &&
+                           data < reinterpret_cast<const char *>(&interned + 1);
+        string_bytes += sizeof(std::string);
+        if (!inline_data) {
+            string_bytes += interned.capacity() + 1;
+        }
+    }
+    return &*res.first;
+}
+
+void gpi_get_memory_stats(gpi_memory_stats *stats) {
+    stats->num_handles = handle_count;
+    stats->handle_bytes = handle_bytes;
+    stats->num_strings = string_table().size();
+    stats->string_bytes = string_bytes;
+}
+
+void *GpiObjHdl::operator new(std::size_t size) {
+    void *ptr = ::operator new(size);
+    handle_count++;
+    handle_bytes += size;
+    return ptr;
+}
 
-const char *GpiObjHdl::get_fullname_str() { return m_fullname.c_str(); }
+void GpiObjHdl::operator delete(void *ptr, std::size_t size) {
+    handle_count--;
+    handle_bytes -= size;
+    ::operator delete(ptr);
+}
 
-const std::string &GpiObjHdl::get_fullname() { return m_fullname; }
+GpiObjHdl::~GpiObjHdl() { delete m_fullname; }
+
+const char *GpiObjHdl::get_name_str() { return get_name().c_str(); }
+
+const char *GpiObjHdl::get_fullname_str() {
+    if (m_fullname) {
+        return m_fullname->c_str();
+    }
+    if (m_fullname_relative) {
+        // callers may hold on to the string, so keep it until the object is
+        // freed
+        m_fullname = new std::string(get_fullname());
+        return m_fullname->c_str();
+    }
+    return m_fullname_part ? m_fullname_part->c_str() : unknown_name.c_str();
+}
+
+std::string GpiObjHdl::get_fullname() {
+    if (m_fullname) {
+        return *m_fullname;
+    }
+    if (!m_fullname_part) {
+        return unknown_name;
+    }
+    if (m_fullname_relative) {
+        return m_parent->get_fullname() + *m_fullname_part;
+    }
+    return *m_fullname_part;
+}
+
+void GpiObjHdl::set_parent(GpiObjHdl *parent) {
+    m_parent = parent;
+    if (!m_fullname) {
+        return;
+    }
+    if (parent) {
+        std::string parent_name = parent->get_fullname();
+        if (m_fullname->compare(0, parent_name.size(), parent_name) == 0) {
+            m_fullname_part =
+                gpi_intern_string(m_fullname->substr(parent_name.size()));
+            m_fullname_relative = true;
+        }
+    }
+    if (!m_fullname_relative) {
+        m_fullname_part = gpi_intern_string(*m_fullname);
+    }
+    delete m_fullname;
+    m_fullname = nullptr;
+}
+
+const char *GpiObjHdl::get_definition_name() {
+    return m_definition_name ? m_definition_name->c_str() : empty_name.c_str();
+}
+
+const char *GpiObjHdl::get_definition_file() {
+    return m_definition_file ? m_definition_file->c_str() : empty_name.c_str();
+}
+
+void GpiObjHdl::set_definition_name(const char *name) {
+    m_definition_name = gpi_intern_string(name);
+}
+
+void GpiObjHdl::set_definition_file(const char *file) {
+    m_definition_file = gpi_intern_string(file);
+}
 
 const char *GpiObjHdl::get_type_str() {
 #define CASE_OPTION(_X) \
@@ -41,7 +153,9 @@ const char *GpiObjHdl::get_type_str() {
     return ret;
 }
 
-const std::string &GpiObjHdl::get_name() { return m_name; }
+const std::string &GpiObjHdl::get_name() {
+    return m_name ? *m_name : unknown_name;
+}
 
 /* Genertic base clss implementations */
 bool GpiHdl::is_this_impl(GpiImplInterface *impl) {
@@ -49,7 +163,254 @@ bool GpiHdl::is_this_impl(GpiImplInterface *impl) {
 }
 
 int GpiObjHdl::initialise(const std::string &name, const std::string &fq_name) {
-    m_name = name;
-    m_fullname = fq_name;
+    m_name = gpi_intern_string(name);
+    delete m_fullname;
+    m_fullname = new std::string(fq_name);
+    m_fullname_part = nullptr;
+    m_fullname_relative = false;
+    return 0;
+}
+
+size_t gpi_array_element_size(int width, gpi_array_format format) {
+    size_t bits = static_cast<size_t>(width);
+    switch (format) {
+        case GPI_ARRAY_UINT:
+            return (bits + 7) / 8;
+        case GPI_ARRAY_REAL:
+            return sizeof(double);
+        default:
+            return bits;
+    }
+}
+
+void gpi_binstr_to_element(const char *binstr, int width,
+                           gpi_array_format format, uint8_t *elem) {
+    // Values are aligned on the least significant bit
+    const int len = static_cast<int>(strlen(binstr));
+    if (format == GPI_ARRAY_UINT) {
+        memset(elem, 0, gpi_array_element_size(width, format));
+        for (int bit = 0; bit < width && bit < len; bit++) {
+            if (binstr[len - 1 - bit] == '1') {
+                elem[bit / 8] |= static_cast<uint8_t>(1u << (bit % 8));
+            }
+        }
+    } else {
+        for (int pos = 0; pos < width; pos++) {
+            const int src = pos - (width - len);
+            elem[pos] = src >= 0 ? static_cast<uint8_t>(toupper(binstr[src]))
+                                 : '0';
+        }
+    }
+}
+
+std::string gpi_element_to_binstr(const uint8_t *elem, int width,
+                                  gpi_array_format format) {
+    std::string binstr(static_cast<size_t>(width), '0');
+    if (format == GPI_ARRAY_UINT) {
+        for (int bit = 0; bit < width; bit++) {
+            if ((elem[bit / 8] >> (bit % 8)) & 1) {
+                binstr[static_cast<size_t>(width - 1 - bit)] = '1';
+            }
+        }
+    } else {
+        binstr.assign(reinterpret_cast<const char *>(elem),
+                      static_cast<size_t>(width));
+    }
+    return binstr;
+}
+
+/* Create an object for an element of an array without storing it, so it can
+ * be deleted again once it has been accessed. Returns NULL if the element
+ * isn't a signal.
+ */
+static GpiSignalObjHdl *temporary_element(GpiObjHdl *array, int index) {
+    GpiObjHdl *elem = array->m_impl->get_child_by_index(index, array);
+    if (!elem) {
+        return NULL;
+    }
+    if (elem->get_handle<void *>() == array->get_handle<void *>()) {
+        elem->set_shares_handle();
+    }
+    switch (elem->get_type()) {
+        case GPI_LOGIC:
+        case GPI_LOGIC_ARRAY:
+        case GPI_INTEGER:
+        case GPI_REAL:
+            return static_cast<GpiSignalObjHdl *>(elem);
+        default:
+            delete elem;
+            return NULL;
+    }
+}
+
+// Real elements are only accessed as GPI_ARRAY_REAL and others only as bits
+static bool element_has_format(GpiSignalObjHdl *elem,
+                               gpi_array_format format) {
+    return (elem->get_type() == GPI_REAL) == (format == GPI_ARRAY_REAL);
+}
+
+int GpiObjHdl::get_element_width() {
+    GpiSignalObjHdl *elem = temporary_element(this, m_range_left);
+    if (!elem) {
+        return -1;
+    }
+    int width = elem->get_type() == GPI_REAL
+                    ? 64
+                    : static_cast<int>(strlen(elem->get_signal_value_binstr()));
+    delete elem;
+    return width > 0 ? width : -1;
+}
+
+int GpiObjHdl::read_elements(int first, int count, gpi_array_format format,
+                             uint8_t *buffer) {
+    const int width = get_element_width();
+    if (width < 0) {
+        LOG_ERROR("Elements of %s are not signals", get_name_str());
+        return -1;
+    }
+    const size_t elem_size = gpi_array_element_size(width, format);
+
+    for (int i = 0; i < count; i++) {
+        const int index = element_index(first, i);
+        GpiSignalObjHdl *elem = temporary_element(this, index);
+        if (!elem || !element_has_format(elem, format)) {
+            LOG_ERROR("Unable to read element %d of %s", index,
+                      get_name_str());
+            delete elem;
+            return -1;
+        }
+        uint8_t *out = buffer + static_cast<size_t>(i) * elem_size;
+        if (format == GPI_ARRAY_REAL) {
+            double value = elem->get_signal_value_real();
+            memcpy(out, &value, sizeof(value));
+        } else {
+            gpi_binstr_to_element(elem->get_signal_value_binstr(), width,
+                                  format, out);
+        }
+        delete elem;
+    }
     return 0;
 }
+
+int GpiObjHdl::write_elements(int first, int count, gpi_array_format format,
+                              const uint8_t *buffer, gpi_set_action action) {
+    const int width = get_element_width();
+    if (width < 0) {
+        LOG_ERROR("Elements of %s are not signals", get_name_str());
+        return -1;
+    }
+    const size_t elem_size = gpi_array_element_size(width, format);
+
+    for (int i = 0; i < count; i++) {
+        const int index = element_index(first, i);
+        GpiSignalObjHdl *elem = temporary_element(this, index);
+        if (!elem || !element_has_format(elem, format)) {
+            LOG_ERROR("Unable to write element %d of %s", index,
+                      get_name_str());
+            delete elem;
+            return -1;
+        }
+        const uint8_t *in = buffer + static_cast<size_t>(i) * elem_size;
+        int ret;
+        if (format == GPI_ARRAY_REAL) {
+            double value;
+            memcpy(&value, in, sizeof(value));
+            ret = elem->set_signal_value(value, action);
+        } else {
+            std::string binstr = gpi_element_to_binstr(in, width, format);
+            ret = elem->set_signal_value_binstr(binstr, action);
+        }
+        delete elem;
+        if (ret) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int GpiSignalObjHdl::get_signal_slice_binstr(int first, int count,
+                                             std::string &value) {
+    const char *binstr = get_signal_value_binstr();
+    if (!binstr || static_cast<int>(strlen(binstr)) < first + count) {
+        LOG_ERROR("Unable to get the value of %s", get_name_str());
+        return -1;
+    }
+    value.assign(binstr + first, static_cast<size_t>(count));
+    return 0;
+}
+
+int GpiSignalObjHdl::set_signal_slice_binstr(int first,
+                                             const std::string &value,
+                                             gpi_set_action action) {
+    const char *binstr = get_signal_value_binstr();
+    if (!binstr || static_cast<int>(strlen(binstr)) != m_num_elems) {
+        LOG_ERROR("Unable to get the value of %s", get_name_str());
+        return -1;
+    }
+    std::string merged(binstr);
+    merged.replace(static_cast<size_t>(first), value.size(), value);
+    return set_signal_value_binstr(merged, action);
+}
+
+void GpiValueFilter::set(const char *mask, const char *target,
+                         const char *current) {
+    clear();
+    m_width = strlen(current);
+    for (size_t i = 0; i < m_width; i++) {
+        if (mask[i] == '1') {
+            m_bits.push_back(i);
+            m_last.push_back(static_cast<char>(
+                toupper(static_cast<unsigned char>(current[i]))));
+            if (target) {
+                m_target.push_back(static_cast<char>(
+                    toupper(static_cast<unsigned char>(target[i]))));
+            }
+        }
+    }
+}
+
+void GpiValueFilter::set_group(GpiCbGroup *group, int member) {
+    clear();
+    m_group = group;
+    m_member = member;
+}
+
+void GpiValueFilter::clear() {
+    m_width = 0;
+    m_bits.clear();
+    m_target.clear();
+    m_last.clear();
+    m_group = nullptr;
+    m_member = -1;
+}
+
+bool GpiValueFilter::pass(const char *binstr) {
+    // LCOV_EXCL_START
+    if (!binstr || strlen(binstr) != m_width) {
+        // Can't be matched up with the mask, so let the user decide
+        return true;
+    }
+    // LCOV_EXCL_STOP
+    bool changed = false;
+    bool on_target = true;
+    for (size_t i = 0; i < m_bits.size(); i++) {
+        char bit = static_cast<char>(
+            toupper(static_cast<unsigned char>(binstr[m_bits[i]])));
+        if (bit != m_last[i]) {
+            m_last[i] = bit;
+            changed = true;
+        }
+        if (!m_target.empty() && bit != m_target[i]) {
+            on_target = false;
+        }
+    }
+    return changed && on_target;
+}
+
+bool GpiValueFilter::pass(GpiSignalObjHdl *signal) {
+    if (m_group) {
+        m_group->member_changed(m_member);
+        return false;
+    }
+    return pass(signal->get_signal_value_binstr());
+}
@@ -5,13 +5,26 @@
 // SPDX-License-Identifier: BSD-3-Clause
 
 #include <cocotb_utils.h>
+#include <gpi_probes.h>
 #include <sys/types.h>
+#ifndef _WIN32
+#include <unistd.h>  // fork, getpid
+#endif
 
 #include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cinttypes>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <map>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
+#include "GpiTrace.h"
 #include "gpi.h"
 #include "gpi_priv.h"
 
@@ -24,54 +37,456 @@ static vector<GpiImplInterface *> registered_impls;
 class GpiHandleStore {
   public:
     GpiObjHdl *check_and_store(GpiObjHdl *hdl) {
-        std::map<std::string, GpiObjHdl *>::iterator it;
-
-        const std::string &name = hdl->get_fullname();
-
-        LOG_DEBUG("Checking %s exists", name.c_str());
+        LOG_DEBUG("Checking %s exists", hdl->get_name_str());
 
-        it = handle_map.find(name);
-        if (it == handle_map.end()) {
-            handle_map[name] = hdl;
+        auto res = handles.insert(hdl);
+        if (res.second) {
+            hdl->retain();
             return hdl;
         } else {
-            LOG_DEBUG("Found duplicate %s", name.c_str());
+            LOG_DEBUG("Found duplicate %s", hdl->get_name_str());
 
+            GpiObjHdl *parent = hdl->get_parent();
             delete hdl;
-            return it->second;
+            release(parent);
+            (*res.first)->retain();
+            return *res.first;
         }
     }
 
-    uint64_t handle_count() { return handle_map.size(); }
+    void release(GpiObjHdl *hdl) {
+        while (hdl && hdl->release()) {
+            LOG_DEBUG("Releasing %s", hdl->get_name_str());
 
-    void clear() {
-        std::map<std::string, GpiObjHdl *>::iterator it;
+            // the full name may be derived from the parent, which this
+            // object keeps alive, so release the parent last
+            GpiObjHdl *parent = hdl->get_parent();
+            handles.erase(hdl);
+            delete hdl;
+            hdl = parent;
+        }
+    }
+
+    uint64_t handle_count() { return handles.size(); }
 
-        // Delete the object handles before clearing the map
-        for (it = handle_map.begin(); it != handle_map.end(); it++) {
-            delete (it->second);
+    void clear() {
+        // Objects keep their parent alive, so delete the deepest ones first
+        std::vector<std::pair<size_t, GpiObjHdl *>> by_depth;
+        by_depth.reserve(handles.size());
+        for (auto hdl : handles) {
+            size_t depth = 0;
+            for (auto p = hdl->get_parent(); p; p = p->get_parent()) {
+                depth++;
+            }
+            by_depth.emplace_back(depth, hdl);
+        }
+        std::sort(by_depth.begin(), by_depth.end(),
+                  [](const std::pair<size_t, GpiObjHdl *> &a,
+                     const std::pair<size_t, GpiObjHdl *> &b) {
+                      return a.first > b.first;
+                  });
+        handles.clear();
+        for (auto &entry : by_depth) {
+            delete entry.second;
         }
-        handle_map.clear();
     }
 
   private:
-    std::map<std::string, GpiObjHdl *> handle_map;
+    // Handles are keyed by their full name, compared through the parent it is
+    // relative to and the interned rest of it so it is never built
+    struct FullnameHash {
+        size_t operator()(GpiObjHdl *hdl) const {
+            size_t seed = std::hash<const void *>()(hdl->get_fullname_parent());
+            size_t part = std::hash<const void *>()(hdl->get_fullname_part());
+            return seed ^ (part + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+        }
+    };
+    struct FullnameEqual {
+        bool operator()(GpiObjHdl *a, GpiObjHdl *b) const {
+            return a == b ||
+                   (a->get_fullname_parent() == b->get_fullname_parent() &&
+                    a->get_fullname_part() == b->get_fullname_part());
+        }
+    };
+    std::unordered_set<GpiObjHdl *, FullnameHash, FullnameEqual> handles;
 };
 
 static GpiHandleStore unique_handles;
 
 #define CHECK_AND_STORE(_x) unique_handles.check_and_store(_x)
+#define RELEASE_FROM_STORE(_x) unique_handles.release(_x)
 #define CLEAR_STORE() unique_handles.clear()
 
 #else
 
-#define CHECK_AND_STORE(_x) _x
+static GpiObjHdl *retain_handle(GpiObjHdl *hdl) {
+    hdl->retain();
+    return hdl;
+}
+
+static void release_handle(GpiObjHdl *hdl) {
+    while (hdl && hdl->release()) {
+        GpiObjHdl *parent = hdl->get_parent();
+        delete hdl;
+        hdl = parent;
+    }
+}
+
+#define CHECK_AND_STORE(_x) retain_handle(_x)
+#define RELEASE_FROM_STORE(_x) release_handle(_x)
 #define CLEAR_STORE() (void)0  // No-op
 
 #endif
 
 static bool sim_ending = false;
 
+/* Performance counters
+ *
+ * These are always collected. The cost is a couple of steady_clock reads per
+ * callback and an increment per signal access, which is small compared to
+ * the simulator and Python work around them.
+ */
+using gpi_clock = std::chrono::steady_clock;
+
+static gpi_stats g_stats;
+static bool g_in_gpi = false;
+static bool g_have_exit = false;
+static gpi_clock::time_point g_gpi_enter;
+static gpi_clock::time_point g_gpi_exit;
+
+static inline uint64_t elapsed_ns(gpi_clock::time_point start,
+                                  gpi_clock::time_point end) {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+            .count());
+}
+
+static inline size_t hist_bucket(uint64_t ns) {
+    size_t bucket = 0;
+    while ((ns >>= 1) && bucket < GPI_STATS_HIST_BUCKETS - 1) {
+        bucket++;
+    }
+    return bucket;
+}
+
+static const char *cb_type_to_string(gpi_cb_type cb_type) {
+    switch (cb_type) {
+        case GPI_CB_TIMED:
+            return "timed";
+        case GPI_CB_VALUE_CHANGE:
+            return "value change";
+        case GPI_CB_READONLY:
+            return "readonly";
+        case GPI_CB_NEXTTIME:
+            return "nexttime";
+        case GPI_CB_READWRITE:
+            return "readwrite";
+        default:
+            return "other";
+    }
+}
+
+static const char *const *g_sim_counter_names = nullptr;
+static uint64_t *g_sim_counters = nullptr;
+static size_t g_num_sim_counters = 0;
+
+void gpi_get_stats(gpi_stats *stats) {
+    *stats = g_stats;
+    stats->num_sim_counters = g_num_sim_counters;
+    for (size_t i = 0; i < g_num_sim_counters; i++) {
+        stats->sim_counter_names[i] = g_sim_counter_names[i];
+        stats->sim_counters[i] = g_sim_counters[i];
+    }
+}
+
+void gpi_reset_stats() {
+    uint64_t threshold = g_stats.slow_cb_threshold_ns;
+    memset(&g_stats, 0, sizeof(g_stats));
+    g_stats.slow_cb_threshold_ns = threshold;
+    for (size_t i = 0; i < g_num_sim_counters; i++) {
+        g_sim_counters[i] = 0;
+    }
+}
+
+void gpi_register_sim_counters(const char *const *names, uint64_t *values,
+                               size_t count) {
+    // LCOV_EXCL_START
+    if (count > GPI_STATS_MAX_SIM_COUNTERS) {
+        LOG_ERROR("Too many simulator counters, only the first %d are kept",
+                  GPI_STATS_MAX_SIM_COUNTERS);
+        count = GPI_STATS_MAX_SIM_COUNTERS;
+    }
+    // LCOV_EXCL_STOP
+    g_sim_counter_names = names;
+    g_sim_counters = values;
+    g_num_sim_counters = count;
+}
+
+void gpi_set_slow_callback_threshold(uint64_t threshold_ns) {
+    g_stats.slow_cb_threshold_ns = threshold_ns;
+}
+
+/* ReadOnly value cache
+ *
+ * Signal values can't change while a ReadOnly callback runs, so when enabled
+ * the first read of a signal in each format is kept until the callback
+ * returns. Any write empties the cache, in case the simulator applies it
+ * immediately.
+ */
+struct CachedValue {
+    unsigned formats = 0;  // Bit mask of the valid gpi_value_format values
+    std::string binstr;
+    std::string str;
+    double real = 0.0;
+    long integer = 0;
+};
+
+static bool g_value_cache_enabled = false;
+static bool g_value_cache_active = false;
+static std::unordered_map<const GpiObjHdl *, CachedValue> g_value_cache;
+
+void gpi_set_readonly_value_cache(bool enable) {
+    g_value_cache_enabled = enable;
+}
+
+static inline void value_cache_clear() {
+    if (!g_value_cache.empty()) {
+        g_value_cache.clear();
+    }
+}
+
+/* Return the cache entry of *hdl* if the value in *format* is cached,
+ * otherwise return a new or partial entry for the caller to fill in. The
+ * caller marks the format as cached once the value has been read.
+ */
+static inline CachedValue *value_cache_lookup(const GpiObjHdl *hdl,
+                                              gpi_value_format format,
+                                              bool &hit) {
+    hit = false;
+    if (!g_value_cache_active) {
+        return nullptr;
+    }
+    CachedValue &entry = g_value_cache[hdl];
+    if (entry.formats & (1u << format)) {
+        g_stats.value_cache_hits++;
+        hit = true;
+    }
+    return &entry;
+}
+
+/* Write elision
+ *
+ * When enabled, the last value deposited on a signal is kept in a packed
+ * buffer and a value change callback is armed on the signal. Depositing the
+ * same value again is dropped until that callback fires, the signal is read,
+ * or another kind of write is made. Writes to whole arrays can't be traced to
+ * the handles of their elements, so they make every shadow stale.
+ */
+struct GpiSignalObjHdl::WriteShadow {
+    gpi_value_format format = GPI_FORMAT_BINSTR;
+    std::string value;
+    uint64_t epoch = 0;  // Valid if it matches g_write_epoch
+    GpiCbHdl *cb = nullptr;
+};
+
+static bool g_write_elision = false;
+static uint64_t g_write_epoch = 1;
+
+void gpi_set_write_elision(bool enable) {
+    g_write_elision = enable;
+    g_write_epoch++;
+}
+
+GpiSignalObjHdl::~GpiSignalObjHdl() {
+    if (m_write_shadow) {
+        if (m_write_shadow->cb && !sim_ending) {
+            m_write_shadow->cb->remove();
+        }
+        delete m_write_shadow;
+    }
+}
+
+static int write_shadow_changed(void *data) {
+    auto shadow = static_cast<GpiSignalObjHdl::WriteShadow *>(data);
+    shadow->epoch = 0;
+    // Value change callbacks are gone once they have fired
+    shadow->cb = nullptr;
+    return 0;
+}
+
+static inline void write_shadow_invalidate(GpiSignalObjHdl *hdl) {
+    if (hdl->m_write_shadow) {
+        hdl->m_write_shadow->epoch = 0;
+    }
+}
+
+/* Return true if the write can be dropped, otherwise forget the last value */
+static bool write_elided(GpiSignalObjHdl *hdl, gpi_value_format format,
+                         const void *value, size_t size,
+                         gpi_set_action action) {
+    GpiSignalObjHdl::WriteShadow *shadow = hdl->m_write_shadow;
+    if (!shadow) {
+        return false;
+    }
+    if (action == GPI_DEPOSIT && shadow->epoch == g_write_epoch &&
+        shadow->format == format && shadow->value.size() == size &&
+        memcmp(shadow->value.data(), value, size) == 0) {
+        g_stats.elided_writes++;
+        return true;
+    }
+    shadow->epoch = 0;
+    return false;
+}
+
+/* Remember a value after it has been deposited */
+static void write_shadow_update(GpiSignalObjHdl *hdl, gpi_value_format format,
+                                const void *value, size_t size,
+                                gpi_set_action action) {
+    if (!g_write_elision || action != GPI_DEPOSIT) {
+        return;
+    }
+    GpiSignalObjHdl::WriteShadow *shadow = hdl->m_write_shadow;
+    if (!shadow) {
+        shadow = hdl->m_write_shadow = new GpiSignalObjHdl::WriteShadow;
+    }
+    if (!shadow->cb) {
+        shadow->cb = hdl->register_value_change_callback(
+            GPI_VALUE_CHANGE, write_shadow_changed, shadow);
+        if (!shadow->cb) {
+            // Changes to this signal can't be seen, so never drop writes
+            return;
+        }
+        shadow->cb->set_internal();
+    }
+    shadow->format = format;
+    shadow->value.assign(static_cast<const char *>(value), size);
+    shadow->epoch = g_write_epoch;
+}
+
+/* Call up to the user, accounting the time spent as a callback of *cb_type*
+ */
+template <typename F>
+static int account_user_callback(gpi_cb_type cb_type, F &&call) {
+    if (gpi_trace_enabled()) {
+        gpi_trace_record(GPI_TRACE_BEGIN, "callback",
+                         cb_type_to_string(cb_type), nullptr);
+    }
+
+    g_value_cache_active = g_value_cache_enabled && cb_type == GPI_CB_READONLY;
+
+    auto start = gpi_clock::now();
+    int res = call();
+    uint64_t ns = elapsed_ns(start, gpi_clock::now());
+
+    g_value_cache_active = false;
+    value_cache_clear();
+
+    if (gpi_trace_enabled()) {
+        gpi_trace_record(GPI_TRACE_END, "callback",
+                         cb_type_to_string(cb_type), nullptr);
+    }
+
+    g_stats.cb_count[cb_type]++;
+    g_stats.cb_time_ns[cb_type] += ns;
+    g_stats.cb_hist[cb_type][hist_bucket(ns)]++;
+
+    if (g_stats.slow_cb_threshold_ns && ns > g_stats.slow_cb_threshold_ns) {
+        g_stats.slow_cb_count++;
+        LOG_WARN("Slow %s callback took %" PRIu64 " us (threshold %" PRIu64
+                 " us)",
+                 cb_type_to_string(cb_type), ns / 1000,
+                 g_stats.slow_cb_threshold_ns / 1000);
+    }
+
+    return res;
+}
+
+/* Callback batching
+ *
+ * While the simulator harness runs a dispatch between
+ * gpi_begin_callback_batch() and gpi_end_callback_batch(), callbacks with the
+ * batched function are collected and handed to the batch function in one
+ * call at the end. A batch is accounted as one callback, of the type of its
+ * callbacks if they all have the same one. If batching is turned off while
+ * callbacks are collected, they are delivered one by one instead.
+ */
+static int (*g_batch_cb_func)(void *) = nullptr;
+static int (*g_batch_func)(void *const *, size_t) = nullptr;
+static int g_batch_depth = 0;
+static std::vector<void *> g_batch;
+static int (*g_batched_cb_func)(void *) = nullptr;  // Of the collected ones
+static gpi_cb_type g_batch_type = GPI_CB_OTHER;
+
+void gpi_set_callback_batching(
+    int (*cb_func)(void *),
+    int (*batch_func)(void *const *cb_data, size_t count)) {
+    g_batch_cb_func = batch_func ? cb_func : nullptr;
+    g_batch_func = batch_func;
+}
+
+void gpi_begin_callback_batch() { g_batch_depth++; }
+
+void gpi_end_callback_batch() {
+    if (--g_batch_depth > 0 || g_batch.empty()) {
+        return;
+    }
+
+    // The batch function may start another batch
+    std::vector<void *> batch;
+    batch.swap(g_batch);
+    g_stats.batched_cb_count += batch.size();
+
+    gpi_to_user();
+    int res = 0;
+    if (g_batch_func) {
+        res = account_user_callback(g_batch_type, [&batch]() {
+            return g_batch_func(batch.data(), batch.size());
+        });
+    } else {
+        auto cb_func = g_batched_cb_func;
+        for (size_t i = 0; i < batch.size() && !res; i++) {
+            res = account_user_callback(g_batch_type, [cb_func, &batch, i]() {
+                return cb_func(batch[i]);
+            });
+        }
+    }
+    if (res) {
+        // sim failed, so call shutdown
+        gpi_embed_end();
+        return;
+    }
+    gpi_to_simulator();
+
+    // Keep the storage for the next batch
+    if (g_batch.empty()) {
+        batch.clear();
+        g_batch.swap(batch);
+    }
+}
+
+int GpiCbHdl::call_cb_func() {
+    if (m_internal) {
+        return m_cb_func(m_cb_data);
+    }
+
+    // run() may delete this object after we return, so take what we need now
+    gpi_cb_type cb_type = m_cb_type;
+
+    if (g_batch_depth && m_cb_func == g_batch_cb_func) {
+        if (g_batch.empty()) {
+            g_batch_type = cb_type;
+        } else if (g_batch_type != cb_type) {
+            g_batch_type = GPI_CB_OTHER;
+        }
+        g_batched_cb_func = m_cb_func;
+        g_batch.push_back(m_cb_data);
+        return 0;
+    }
+
+    return account_user_callback(cb_type,
+                                 [this]() { return m_cb_func(m_cb_data); });
+}
+
 static size_t gpi_print_registered_impl() {
     vector<GpiImplInterface *>::iterator iter;
     for (iter = registered_impls.begin(); iter != registered_impls.end();
@@ -116,8 +531,19 @@ void gpi_sim_end() {
 }
 
 void gpi_cleanup(void) {
-    CLEAR_STORE();
+    // Flush first, the recorded events refer to handle names
+    gpi_trace_flush();
+    gpi_native_logger_flush();
+    // Python may still refer to the handles until it's finalized
     embed_sim_cleanup();
+
+    gpi_memory_stats mem;
+    gpi_get_memory_stats(&mem);
+    LOG_DEBUG("%zu handles using %zu bytes, %zu strings using %zu bytes",
+              mem.num_handles, mem.handle_bytes, mem.num_strings,
+              mem.string_bytes);
+
+    CLEAR_STORE();
 }
 
 static void gpi_load_libs(std::vector<std::string> to_load) {
@@ -161,7 +587,35 @@ static void gpi_load_libs(std::vector<std::string> to_load) {
     }
 }
 
+static bool gpi_log_sim_time(double *time_ns) {
+    if (registered_impls.empty()) {
+        return false;
+    }
+    uint32_t high, low;
+    int32_t precision;
+    registered_impls[0]->get_sim_time(&high, &low);
+    registered_impls[0]->get_sim_precision(&precision);
+    uint64_t steps = (static_cast<uint64_t>(high) << 32) | low;
+    *time_ns = static_cast<double>(steps) * pow(10.0, precision + 9);
+    return true;
+}
+
+static bool log_async_enabled = false;
+
 void gpi_entry_point() {
+    gpi_native_logger_set_sim_time_func(gpi_log_sim_time);
+
+    const char *log_async = getenv("GPI_LOG_ASYNC");
+    if (log_async && strcmp(log_async, "1") == 0) {
+        if (gpi_native_logger_set_async(true)) {
+            log_async_enabled = true;
+        } else {
+            // LCOV_EXCL_START
+            LOG_ERROR("Unable to start the asynchronous log writer");
+            // LCOV_EXCL_STOP
+        }
+    }
+
     const char *log_level = getenv("GPI_LOG_LEVEL");
     if (log_level) {
         static const std::map<std::string, int> log_level_str_table = {
@@ -178,6 +632,47 @@ void gpi_entry_point() {
         }
     }
 
+    const char *slow_cb_threshold = getenv("GPI_SLOW_CALLBACK_THRESHOLD");
+    if (slow_cb_threshold) {
+        char *end;
+        unsigned long long threshold_us = strtoull(slow_cb_threshold, &end, 10);
+        if (*slow_cb_threshold != '\0' && *end == '\0') {
+            gpi_set_slow_callback_threshold(threshold_us * 1000);
+        } else {
+            // LCOV_EXCL_START
+            LOG_ERROR("Invalid slow callback threshold: %s", slow_cb_threshold);
+            // LCOV_EXCL_STOP
+        }
+    }
+
+    const char *value_cache = getenv("GPI_READONLY_VALUE_CACHE");
+    if (value_cache && strcmp(value_cache, "1") == 0) {
+        gpi_set_readonly_value_cache(true);
+    }
+
+    const char *write_elision = getenv("GPI_WRITE_ELISION");
+    if (write_elision && strcmp(write_elision, "1") == 0) {
+        gpi_set_write_elision(true);
+    }
+
+    const char *trace_file = getenv("GPI_TRACE_FILE");
+    if (trace_file && *trace_file) {
+        size_t capacity = 1000000;
+        const char *trace_size = getenv("GPI_TRACE_BUFFER_SIZE");
+        if (trace_size) {
+            char *end;
+            unsigned long long val = strtoull(trace_size, &end, 10);
+            if (*trace_size != '\0' && *end == '\0') {
+                capacity = static_cast<size_t>(val);
+            } else {
+                // LCOV_EXCL_START
+                LOG_ERROR("Invalid trace buffer size: %s", trace_size);
+                // LCOV_EXCL_STOP
+            }
+        }
+        gpi_trace_open(trace_file, capacity);
+    }
+
     /* Lets look at what other libs we were asked to load too */
     char *lib_env = getenv("GPI_EXTRA");
 
@@ -247,14 +742,30 @@ gpi_sim_hdl gpi_get_root_handle(const char *name) {
         }
     }
 
-    if (hdl)
-        return CHECK_AND_STORE(hdl);
-    else {
+    if (hdl) {
+        hdl->set_parent(NULL);
+        hdl = CHECK_AND_STORE(hdl);
+        GPI_PROBE3(object_handle, hdl, static_cast<GpiObjHdl *>(NULL),
+                   hdl->get_name_str());
+        return hdl;
+    } else {
         LOG_ERROR("No root handle found");
         return hdl;
     }
 }
 
+static GpiObjHdl *store_child(GpiObjHdl *parent, GpiObjHdl *hdl) {
+    if (hdl->get_handle<void *>() == parent->get_handle<void *>()) {
+        hdl->set_shares_handle();
+    }
+    hdl->set_parent(parent);
+    // the parent's name and simulator handle must outlive this object
+    parent->retain();
+    hdl = CHECK_AND_STORE(hdl);
+    GPI_PROBE3(object_handle, hdl, parent, hdl->get_name_str());
+    return hdl;
+}
+
 static GpiObjHdl *gpi_get_child_by_name(GpiObjHdl *parent,
                                         const std::string &name,
                                         GpiImplInterface *skip_impl) {
@@ -264,7 +775,7 @@ static GpiObjHdl *gpi_get_child_by_name(GpiObjHdl *parent,
     if (!skip_impl || (skip_impl != parent->m_impl)) {
         auto hdl = parent->m_impl->get_child_by_name(name, parent);
         if (hdl) {
-            return CHECK_AND_STORE(hdl);
+            return store_child(parent, hdl);
         }
     }
 
@@ -296,7 +807,7 @@ static GpiObjHdl *gpi_get_child_by_name(GpiObjHdl *parent,
         auto hdl = (*iter)->get_child_by_name(name, parent);
         if (hdl) {
             LOG_DEBUG("Found %s via %s", name.c_str(), (*iter)->get_name_c());
-            return CHECK_AND_STORE(hdl);
+            return store_child(parent, hdl);
         }
     }
 
@@ -324,7 +835,7 @@ static GpiObjHdl *gpi_get_child_from_handle(GpiObjHdl *parent, void *raw_hdl,
     }
 
     if (hdl)
-        return CHECK_AND_STORE(hdl);
+        return store_child(parent, hdl);
     else {
         LOG_WARN(
             "Failed to convert a raw handle to valid object via any registered "
@@ -351,7 +862,9 @@ gpi_sim_hdl gpi_get_handle_by_name(gpi_sim_hdl base, const char *name,
          * simulators that misbehave during (optional) signal discovery.
          */
         hdl = base->m_impl->get_child_by_name(name, base);
-        if (!hdl) {
+        if (hdl) {
+            hdl = store_child(base, hdl);
+        } else {
             LOG_DEBUG(
                 "Failed to find a handle named %s via native implementation",
                 name);
@@ -375,7 +888,7 @@ gpi_sim_hdl gpi_get_handle_by_index(gpi_sim_hdl base, int32_t index) {
     hdl = intf->get_child_by_index(index, base);
 
     if (hdl)
-        return CHECK_AND_STORE(hdl);
+        return store_child(base, hdl);
     else {
         LOG_WARN(
             "Failed to find a handle at index %d via any registered "
@@ -425,7 +938,7 @@ gpi_sim_hdl gpi_next(gpi_iterator_hdl iter) {
         switch (ret) {
             case GpiIterator::NATIVE:
                 LOG_DEBUG("Create a native handle");
-                return CHECK_AND_STORE(next);
+                return store_child(parent, next);
             case GpiIterator::NATIVE_NO_NAME:
                 LOG_DEBUG("Unable to fully setup handle, skipping");
                 continue;
@@ -470,25 +983,93 @@ static std::string g_binstr;
 
 const char *gpi_get_signal_value_binstr(gpi_sim_hdl sig_hdl) {
     GpiSignalObjHdl *obj_hdl = static_cast<GpiSignalObjHdl *>(sig_hdl);
+    g_stats.reads[GPI_FORMAT_BINSTR]++;
+    write_shadow_invalidate(obj_hdl);
+    GPI_PROBE2(signal_get, obj_hdl, GPI_FORMAT_BINSTR);
+    if (gpi_trace_enabled()) {
+        gpi_trace_record(GPI_TRACE_INSTANT, "signal", "get binstr",
+                         obj_hdl->get_fullname_str());
+    }
+    bool hit;
+    CachedValue *cached = value_cache_lookup(obj_hdl, GPI_FORMAT_BINSTR, hit);
+    if (hit) {
+        return cached->binstr.c_str();
+    }
     g_binstr = obj_hdl->get_signal_value_binstr();
     std::transform(g_binstr.begin(), g_binstr.end(), g_binstr.begin(),
                    ::toupper);
+    if (cached) {
+        cached->binstr = g_binstr;
+        cached->formats |= 1u << GPI_FORMAT_BINSTR;
+    }
     return g_binstr.c_str();
 }
 
 const char *gpi_get_signal_value_str(gpi_sim_hdl sig_hdl) {
     GpiSignalObjHdl *obj_hdl = static_cast<GpiSignalObjHdl *>(sig_hdl);
-    return obj_hdl->get_signal_value_str();
+    g_stats.reads[GPI_FORMAT_STR]++;
+    write_shadow_invalidate(obj_hdl);
+    GPI_PROBE2(signal_get, obj_hdl, GPI_FORMAT_STR);
+    if (gpi_trace_enabled()) {
+        gpi_trace_record(GPI_TRACE_INSTANT, "signal", "get str",
+                         obj_hdl->get_fullname_str());
+    }
+    bool hit;
+    CachedValue *cached = value_cache_lookup(obj_hdl, GPI_FORMAT_STR, hit);
+    if (hit) {
+        return cached->str.c_str();
+    }
+    const char *value = obj_hdl->get_signal_value_str();
+    // NULL if the value can't be read, which is not cached
+    if (cached && value) {
+        cached->str = value;
+        cached->formats |= 1u << GPI_FORMAT_STR;
+    }
+    return value;
 }
 
 double gpi_get_signal_value_real(gpi_sim_hdl sig_hdl) {
     GpiSignalObjHdl *obj_hdl = static_cast<GpiSignalObjHdl *>(sig_hdl);
-    return obj_hdl->get_signal_value_real();
+    g_stats.reads[GPI_FORMAT_REAL]++;
+    write_shadow_invalidate(obj_hdl);
+    GPI_PROBE2(signal_get, obj_hdl, GPI_FORMAT_REAL);
+    if (gpi_trace_enabled()) {
+        gpi_trace_record(GPI_TRACE_INSTANT, "signal", "get real",
+                         obj_hdl->get_fullname_str());
+    }
+    bool hit;
+    CachedValue *cached = value_cache_lookup(obj_hdl, GPI_FORMAT_REAL, hit);
+    if (hit) {
+        return cached->real;
+    }
+    auto value = obj_hdl->get_signal_value_real();
+    if (cached) {
+        cached->real = value;
+        cached->formats |= 1u << GPI_FORMAT_REAL;
+    }
+    return value;
 }
 
 long gpi_get_signal_value_long(gpi_sim_hdl sig_hdl) {
     GpiSignalObjHdl *obj_hdl = static_cast<GpiSignalObjHdl *>(sig_hdl);
-    return obj_hdl->get_signal_value_long();
+    g_stats.reads[GPI_FORMAT_INT]++;
+    write_shadow_invalidate(obj_hdl);
+    GPI_PROBE2(signal_get, obj_hdl, GPI_FORMAT_INT);
+    if (gpi_trace_enabled()) {
+        gpi_trace_record(GPI_TRACE_INSTANT, "signal", "get int",
+                         obj_hdl->get_fullname_str());
+    }
+    bool hit;
+    CachedValue *cached = value_cache_lookup(obj_hdl, GPI_FORMAT_INT, hit);
+    if (hit) {
+        return cached->integer;
+    }
+    auto value = obj_hdl->get_signal_value_long();
+    if (cached) {
+        cached->integer = value;
+        cached->formats |= 1u << GPI_FORMAT_INT;
+    }
+    return value;
 }
 
 const char *gpi_get_signal_name_str(gpi_sim_hdl sig_hdl) {
@@ -514,31 +1095,292 @@ int gpi_is_indexable(gpi_sim_hdl obj_hdl) {
     return 0;
 }
 
+void gpi_release_handle(gpi_sim_hdl obj_hdl) {
+    // The address may be reused by a new handle
+    g_value_cache.erase(obj_hdl);
+    RELEASE_FROM_STORE(obj_hdl);
+}
+
+void gpi_get_object_info(gpi_sim_hdl obj_hdl, gpi_object_info *info) {
+    info->type = obj_hdl->get_type();
+    info->range_dir = obj_hdl->get_range_dir();
+    info->range_left = obj_hdl->get_range_left();
+    info->range_right = obj_hdl->get_range_right();
+    info->num_elems = obj_hdl->get_num_elems();
+    info->is_const = obj_hdl->get_const() ? 1 : 0;
+    info->is_indexable = obj_hdl->get_indexable() ? 1 : 0;
+    info->name = obj_hdl->get_name_str();
+    info->type_str = obj_hdl->get_type_str();
+    info->definition_name = obj_hdl->get_definition_name();
+    info->definition_file = obj_hdl->get_definition_file();
+}
+
+void gpi_set_user_data(gpi_sim_hdl obj_hdl, void *user_data) {
+    obj_hdl->set_user_data(user_data);
+}
+
+void *gpi_get_user_data(gpi_sim_hdl obj_hdl) {
+    return obj_hdl->get_user_data();
+}
+
 void gpi_set_signal_value_int(gpi_sim_hdl sig_hdl, int32_t value,
                               gpi_set_action action) {
     GpiSignalObjHdl *obj_hdl = static_cast<GpiSignalObjHdl *>(sig_hdl);
-
-    obj_hdl->set_signal_value(value, action);
+    g_stats.writes[GPI_FORMAT_INT]++;
+    GPI_PROBE3(signal_set, obj_hdl, GPI_FORMAT_INT, action);
+    if (gpi_trace_enabled()) {
+        gpi_trace_record(GPI_TRACE_INSTANT, "signal", "set int",
+                         obj_hdl->get_fullname_str());
+    }
+    value_cache_clear();
+    if (write_elided(obj_hdl, GPI_FORMAT_INT, &value, sizeof(value), action)) {
+        return;
+    }
+    if (!obj_hdl->set_signal_value(value, action)) {
+        write_shadow_update(obj_hdl, GPI_FORMAT_INT, &value, sizeof(value),
+                            action);
+    }
 }
 
 void gpi_set_signal_value_binstr(gpi_sim_hdl sig_hdl, const char *binstr,
                                  gpi_set_action action) {
     std::string value = binstr;
     GpiSignalObjHdl *obj_hdl = static_cast<GpiSignalObjHdl *>(sig_hdl);
-    obj_hdl->set_signal_value_binstr(value, action);
+    g_stats.writes[GPI_FORMAT_BINSTR]++;
+    GPI_PROBE3(signal_set, obj_hdl, GPI_FORMAT_BINSTR, action);
+    if (gpi_trace_enabled()) {
+        gpi_trace_record(GPI_TRACE_INSTANT, "signal", "set binstr",
+                         obj_hdl->get_fullname_str());
+    }
+    value_cache_clear();
+    if (write_elided(obj_hdl, GPI_FORMAT_BINSTR, value.data(), value.size(),
+                     action)) {
+        return;
+    }
+    if (!obj_hdl->set_signal_value_binstr(value, action)) {
+        write_shadow_update(obj_hdl, GPI_FORMAT_BINSTR, value.data(),
+                            value.size(), action);
+    }
 }
 
 void gpi_set_signal_value_str(gpi_sim_hdl sig_hdl, const char *str,
                               gpi_set_action action) {
     std::string value = str;
     GpiSignalObjHdl *obj_hdl = static_cast<GpiSignalObjHdl *>(sig_hdl);
-    obj_hdl->set_signal_value_str(value, action);
+    g_stats.writes[GPI_FORMAT_STR]++;
+    GPI_PROBE3(signal_set, obj_hdl, GPI_FORMAT_STR, action);
+    if (gpi_trace_enabled()) {
+        gpi_trace_record(GPI_TRACE_INSTANT, "signal", "set str",
+                         obj_hdl->get_fullname_str());
+    }
+    value_cache_clear();
+    if (write_elided(obj_hdl, GPI_FORMAT_STR, value.data(), value.size(),
+                     action)) {
+        return;
+    }
+    if (!obj_hdl->set_signal_value_str(value, action)) {
+        write_shadow_update(obj_hdl, GPI_FORMAT_STR, value.data(),
+                            value.size(), action);
+    }
 }
 
 void gpi_set_signal_value_real(gpi_sim_hdl sig_hdl, double value,
                                gpi_set_action action) {
     GpiSignalObjHdl *obj_hdl = static_cast<GpiSignalObjHdl *>(sig_hdl);
-    obj_hdl->set_signal_value(value, action);
+    g_stats.writes[GPI_FORMAT_REAL]++;
+    GPI_PROBE3(signal_set, obj_hdl, GPI_FORMAT_REAL, action);
+    if (gpi_trace_enabled()) {
+        gpi_trace_record(GPI_TRACE_INSTANT, "signal", "set real",
+                         obj_hdl->get_fullname_str());
+    }
+    value_cache_clear();
+    if (write_elided(obj_hdl, GPI_FORMAT_REAL, &value, sizeof(value),
+                     action)) {
+        return;
+    }
+    if (!obj_hdl->set_signal_value(value, action)) {
+        write_shadow_update(obj_hdl, GPI_FORMAT_REAL, &value, sizeof(value),
+                            action);
+    }
+}
+
+int gpi_get_array_element_width(gpi_sim_hdl obj_hdl) {
+    if (obj_hdl->get_type() != GPI_ARRAY) {
+        return -1;
+    }
+    return obj_hdl->get_element_width();
+}
+
+/* Check that *count* elements starting at index *first* are in the array */
+static bool check_array_span(gpi_sim_hdl obj_hdl, int first, int count) {
+    if (obj_hdl->get_type() != GPI_ARRAY) {
+        LOG_ERROR("%s is not an array", obj_hdl->get_name_str());
+        return false;
+    }
+    const int left = obj_hdl->get_range_left();
+    const int offset = obj_hdl->get_range_dir() == GPI_RANGE_DOWN
+                           ? left - first
+                           : first - left;
+    if (count < 0 || offset < 0 || offset > obj_hdl->get_num_elems() - count) {
+        LOG_ERROR("%d elements at index %d are out of range of %s", count,
+                  first, obj_hdl->get_name_str());
+        return false;
+    }
+    return true;
+}
+
+int gpi_read_array(gpi_sim_hdl obj_hdl, int first, int count,
+                   gpi_array_format format, void *buffer) {
+    if (!check_array_span(obj_hdl, first, count)) {
+        return -1;
+    }
+    if (gpi_trace_enabled()) {
+        gpi_trace_record(GPI_TRACE_INSTANT, "signal", "read array",
+                         obj_hdl->get_fullname_str());
+    }
+    return obj_hdl->read_elements(first, count, format,
+                                  static_cast<uint8_t *>(buffer));
+}
+
+int gpi_write_array(gpi_sim_hdl obj_hdl, int first, int count,
+                    gpi_array_format format, const void *buffer,
+                    gpi_set_action action) {
+    if (!check_array_span(obj_hdl, first, count)) {
+        return -1;
+    }
+    if (gpi_trace_enabled()) {
+        gpi_trace_record(GPI_TRACE_INSTANT, "signal", "write array",
+                         obj_hdl->get_fullname_str());
+    }
+    value_cache_clear();
+    g_write_epoch++;
+    return obj_hdl->write_elements(first, count, format,
+                                   static_cast<const uint8_t *>(buffer),
+                                   action);
+}
+
+/* Find the position from the left and the length of the slice from index
+ * *left* to *right* of a vector
+ */
+static bool check_signal_slice(gpi_sim_hdl obj_hdl, int left, int right,
+                               int &first, int &count) {
+    if (obj_hdl->get_type() != GPI_LOGIC_ARRAY) {
+        LOG_ERROR("%s is not a logic vector", obj_hdl->get_name_str());
+        return false;
+    }
+    const bool down = obj_hdl->get_range_dir() == GPI_RANGE_DOWN;
+    const int range_left = obj_hdl->get_range_left();
+    const int range_right = obj_hdl->get_range_right();
+    const int length = down ? range_left - range_right + 1
+                            : range_right - range_left + 1;
+    first = down ? range_left - left : left - range_left;
+    count = (down ? left - right : right - left) + 1;
+    // Indices of multi-dimensional vectors only cover the outer dimension
+    if (length != obj_hdl->get_num_elems() || count < 1 || first < 0 ||
+        first > length - count) {
+        LOG_ERROR("Slice %d to %d is out of range of %s", left, right,
+                  obj_hdl->get_name_str());
+        return false;
+    }
+    return true;
+}
+
+const char *gpi_get_signal_slice(gpi_sim_hdl sig_hdl, int left, int right) {
+    int first;
+    int count;
+    if (!check_signal_slice(sig_hdl, left, right, first, count)) {
+        return NULL;
+    }
+    g_stats.reads[GPI_FORMAT_BINSTR]++;
+    if (gpi_trace_enabled()) {
+        gpi_trace_record(GPI_TRACE_INSTANT, "signal", "get slice",
+                         sig_hdl->get_fullname_str());
+    }
+    write_shadow_invalidate(static_cast<GpiSignalObjHdl *>(sig_hdl));
+    if (static_cast<GpiSignalObjHdl *>(sig_hdl)->get_signal_slice_binstr(
+            first, count, g_binstr)) {
+        return NULL;
+    }
+    std::transform(g_binstr.begin(), g_binstr.end(), g_binstr.begin(),
+                   ::toupper);
+    return g_binstr.c_str();
+}
+
+int gpi_set_signal_slice(gpi_sim_hdl sig_hdl, int left, int right,
+                         const char *binstr, gpi_set_action action) {
+    int first;
+    int count;
+    if (!check_signal_slice(sig_hdl, left, right, first, count)) {
+        return -1;
+    }
+    std::string value(binstr);
+    if (static_cast<int>(value.size()) != count) {
+        LOG_ERROR("Value of %zu bits doesn't fit slice %d to %d of %s",
+                  value.size(), left, right, sig_hdl->get_name_str());
+        return -1;
+    }
+    g_stats.writes[GPI_FORMAT_BINSTR]++;
+    if (gpi_trace_enabled()) {
+        gpi_trace_record(GPI_TRACE_INSTANT, "signal", "set slice",
+                         sig_hdl->get_fullname_str());
+    }
+    value_cache_clear();
+    write_shadow_invalidate(static_cast<GpiSignalObjHdl *>(sig_hdl));
+    return static_cast<GpiSignalObjHdl *>(sig_hdl)->set_signal_slice_binstr(
+        first, value, action);
+}
+
+/* Check that all of *count* objects are real signals */
+static bool check_real_signals(const gpi_sim_hdl *hdls, int count) {
+    for (int i = 0; i < count; i++) {
+        if (hdls[i]->get_type() != GPI_REAL) {
+            LOG_ERROR("%s is not a real signal", hdls[i]->get_name_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+int gpi_get_signal_values_real(const gpi_sim_hdl *hdls, int count,
+                               double *values) {
+    if (!check_real_signals(hdls, count)) {
+        return -1;
+    }
+    g_stats.reads[GPI_FORMAT_REAL] += static_cast<uint64_t>(count);
+    if (gpi_trace_enabled()) {
+        gpi_trace_record(GPI_TRACE_INSTANT, "signal", "get reals", NULL);
+    }
+    for (int i = 0; i < count; i++) {
+        auto hdl = static_cast<GpiSignalObjHdl *>(hdls[i]);
+        write_shadow_invalidate(hdl);
+        values[i] = hdl->get_signal_value_real();
+    }
+    return 0;
+}
+
+int gpi_set_signal_values_real(const gpi_sim_hdl *hdls, int count,
+                               const double *values, gpi_set_action action) {
+    if (!check_real_signals(hdls, count)) {
+        return -1;
+    }
+    g_stats.writes[GPI_FORMAT_REAL] += static_cast<uint64_t>(count);
+    if (gpi_trace_enabled()) {
+        gpi_trace_record(GPI_TRACE_INSTANT, "signal", "set reals", NULL);
+    }
+    value_cache_clear();
+    for (int i = 0; i < count; i++) {
+        auto hdl = static_cast<GpiSignalObjHdl *>(hdls[i]);
+        if (write_elided(hdl, GPI_FORMAT_REAL, &values[i], sizeof(double),
+                         action)) {
+            continue;
+        }
+        if (hdl->set_signal_value(values[i], action)) {
+            return -1;
+        }
+        write_shadow_update(hdl, GPI_FORMAT_REAL, &values[i], sizeof(double),
+                            action);
+    }
+    return 0;
 }
 
 int gpi_get_num_elems(gpi_sim_hdl obj_hdl) { return obj_hdl->get_num_elems(); }
@@ -555,11 +1397,24 @@ gpi_range_dir gpi_get_range_dir(gpi_sim_hdl obj_hdl) {
     return obj_hdl->get_range_dir();
 }
 
+/* Get *sig_hdl* as a signal, or NULL if it can't change value */
+static GpiSignalObjHdl *value_change_signal(gpi_sim_hdl sig_hdl) {
+    auto signal_hdl = dynamic_cast<GpiSignalObjHdl *>(sig_hdl);
+    if (!signal_hdl) {
+        LOG_ERROR("%s is not a signal, so can't be watched for value changes",
+                  sig_hdl->get_name_str());
+    }
+    return signal_hdl;
+}
+
 gpi_cb_hdl gpi_register_value_change_callback(int (*gpi_function)(void *),
                                               void *gpi_cb_data,
                                               gpi_sim_hdl sig_hdl,
                                               gpi_edge edge) {
-    GpiSignalObjHdl *signal_hdl = static_cast<GpiSignalObjHdl *>(sig_hdl);
+    GpiSignalObjHdl *signal_hdl = value_change_signal(sig_hdl);
+    if (!signal_hdl) {
+        return NULL;
+    }
 
     /* Do something based on int & GPI_RISING | GPI_FALLING */
     GpiCbHdl *gpi_hdl = signal_hdl->register_value_change_callback(
@@ -568,10 +1423,212 @@ gpi_cb_hdl gpi_register_value_change_callback(int (*gpi_function)(void *),
         LOG_ERROR("Failed to register a value change callback");
         return NULL;
     } else {
+        gpi_hdl->set_cb_type(GPI_CB_VALUE_CHANGE);
+        if (gpi_trace_enabled()) {
+            gpi_trace_record(GPI_TRACE_INSTANT, "register",
+                             cb_type_to_string(GPI_CB_VALUE_CHANGE),
+                             signal_hdl->get_fullname_str());
+        }
         return gpi_hdl;
     }
 }
 
+gpi_cb_hdl gpi_register_masked_value_change_callback(
+    int (*gpi_function)(void *), void *gpi_cb_data, gpi_sim_hdl sig_hdl,
+    const char *mask, const char *value) {
+    GpiSignalObjHdl *signal_hdl = value_change_signal(sig_hdl);
+    if (!signal_hdl) {
+        return NULL;
+    }
+
+    const char *binstr = signal_hdl->get_signal_value_binstr();
+    if (!binstr) {
+        LOG_ERROR("Unable to read the value of %s", signal_hdl->get_name_str());
+        return NULL;
+    }
+    std::string current = binstr;
+    if (strlen(mask) != current.size() ||
+        (value && strlen(value) != current.size())) {
+        LOG_ERROR("Mask and value must have the %zu bits of %s",
+                  current.size(), signal_hdl->get_name_str());
+        return NULL;
+    }
+    if (!strchr(mask, '1')) {
+        LOG_ERROR("Mask doesn't select any bits of %s",
+                  signal_hdl->get_name_str());
+        return NULL;
+    }
+
+    GpiCbHdl *gpi_hdl = signal_hdl->register_value_change_callback(
+        GPI_VALUE_CHANGE, gpi_function, gpi_cb_data);
+    if (!gpi_hdl) {
+        LOG_ERROR("Failed to register a value change callback");
+        return NULL;
+    }
+    GpiValueFilter *filter = gpi_hdl->get_value_filter();
+    // LCOV_EXCL_START
+    if (!filter) {
+        LOG_ERROR("Value change callbacks of %s can't be masked",
+                  signal_hdl->get_name_str());
+        gpi_hdl->remove();
+        return NULL;
+    }
+    // LCOV_EXCL_STOP
+    filter->set(mask, value, current.c_str());
+
+    gpi_hdl->set_cb_type(GPI_CB_VALUE_CHANGE);
+    if (gpi_trace_enabled()) {
+        gpi_trace_record(GPI_TRACE_INSTANT, "register",
+                         cb_type_to_string(GPI_CB_VALUE_CHANGE),
+                         signal_hdl->get_fullname_str());
+    }
+    return gpi_hdl;
+}
+
+// Members never call up, their changes are reported through the filter
+static int ignore_member_cb(void *) { return 0; }
+
+GpiCbGroup::~GpiCbGroup() {
+    for (int member = 0; member < (int)m_members.size(); member++) {
+        if (m_members[member].signal) {
+            remove(member);
+        }
+    }
+    set_armed(false);
+}
+
+int GpiCbGroup::add(GpiSignalObjHdl *signal) {
+    int member;
+    if (m_free.empty()) {
+        member = (int)m_members.size();
+        m_members.push_back({nullptr, nullptr, false});
+    } else {
+        member = m_free.back();
+        m_free.pop_back();
+    }
+
+    GpiCbHdl *cb = gpi_register_value_change_callback(
+        ignore_member_cb, nullptr, signal, GPI_VALUE_CHANGE);
+    if (!cb) {
+        m_free.push_back(member);
+        return -1;
+    }
+    GpiValueFilter *filter = cb->get_value_filter();
+    // LCOV_EXCL_START
+    if (!filter) {
+        LOG_ERROR("Value change callbacks of %s can't be grouped",
+                  signal->get_name_str());
+        gpi_remove_cb(cb);
+        m_free.push_back(member);
+        return -1;
+    }
+    // LCOV_EXCL_STOP
+    filter->set_group(this, member);
+
+    // The callback refers to the signal, so keep it alive
+    signal->retain();
+    m_members[(size_t)member] = {signal, cb, false};
+    return member;
+}
+
+int GpiCbGroup::remove(int member) {
+    if (member < 0 || member >= (int)m_members.size() ||
+        !m_members[(size_t)member].signal) {
+        return 1;
+    }
+    Member &m = m_members[(size_t)member];
+    if (!sim_ending) {
+        gpi_remove_cb(m.cb);
+    }
+    gpi_release_handle(m.signal);
+    if (m.changed) {
+        m_changed.erase(
+            std::find(m_changed.begin(), m_changed.end(), member));
+    }
+    // The identifier may be reused
+    m_fired.erase(std::remove(m_fired.begin(), m_fired.end(), member),
+                  m_fired.end());
+    m = {nullptr, nullptr, false};
+    m_free.push_back(member);
+    return 0;
+}
+
+void GpiCbGroup::set_armed(bool armed) {
+    m_armed = armed;
+    if (armed) {
+        return;
+    }
+    if (m_fire_cb && !sim_ending) {
+        gpi_remove_cb(m_fire_cb);
+    }
+    m_fire_cb = nullptr;
+    for (int member : m_changed) {
+        m_members[(size_t)member].changed = false;
+    }
+    m_changed.clear();
+}
+
+void GpiCbGroup::member_changed(int member) {
+    Member &m = m_members[(size_t)member];
+    if (!m_armed || m.changed) {
+        return;
+    }
+    m.changed = true;
+    m_changed.push_back(member);
+    if (!m_fire_cb) {
+        m_fire_cb = gpi_register_readwrite_callback(fire, this);
+        if (!m_fire_cb) {
+            LOG_ERROR("Failed to schedule a callback group");
+        }
+    }
+}
+
+int GpiCbGroup::fire(void *data) {
+    auto group = static_cast<GpiCbGroup *>(data);
+    // Phase callbacks are gone once they have fired
+    group->m_fire_cb = nullptr;
+    if (group->m_changed.empty()) {
+        // All the members which changed were removed
+        return 0;
+    }
+    group->m_fired.swap(group->m_changed);
+    group->m_changed.clear();
+    for (int member : group->m_fired) {
+        group->m_members[(size_t)member].changed = false;
+    }
+    group->m_armed = false;
+    return group->m_cb_func(group->m_cb_data);
+}
+
+gpi_cb_group_hdl gpi_create_cb_group(int (*gpi_function)(void *),
+                                     void *gpi_cb_data) {
+    return new GpiCbGroup(gpi_function, gpi_cb_data);
+}
+
+int gpi_cb_group_add(gpi_cb_group_hdl group, gpi_sim_hdl sig_hdl) {
+    GpiSignalObjHdl *signal_hdl = value_change_signal(sig_hdl);
+    if (!signal_hdl) {
+        return -1;
+    }
+    return group->add(signal_hdl);
+}
+
+int gpi_cb_group_remove(gpi_cb_group_hdl group, int member) {
+    return group->remove(member);
+}
+
+void gpi_cb_group_set_armed(gpi_cb_group_hdl group, bool armed) {
+    group->set_armed(armed);
+}
+
+size_t gpi_cb_group_get_changed(gpi_cb_group_hdl group, const int **members) {
+    const std::vector<int> &changed = group->get_changed();
+    *members = changed.data();
+    return changed.size();
+}
+
+void gpi_destroy_cb_group(gpi_cb_group_hdl group) { delete group; }
+
 gpi_cb_hdl gpi_register_timed_callback(int (*gpi_function)(void *),
                                        void *gpi_cb_data, uint64_t time) {
     // It should not matter which implementation we use for this so just pick
@@ -582,6 +1639,11 @@ gpi_cb_hdl gpi_register_timed_callback(int (*gpi_function)(void *),
         LOG_ERROR("Failed to register a timed callback");
         return NULL;
     } else {
+        gpi_hdl->set_cb_type(GPI_CB_TIMED);
+        if (gpi_trace_enabled()) {
+            gpi_trace_record(GPI_TRACE_INSTANT, "register",
+                             cb_type_to_string(GPI_CB_TIMED), nullptr);
+        }
         return gpi_hdl;
     }
 }
@@ -596,6 +1658,11 @@ gpi_cb_hdl gpi_register_readonly_callback(int (*gpi_function)(void *),
         LOG_ERROR("Failed to register a readonly callback");
         return NULL;
     } else {
+        gpi_hdl->set_cb_type(GPI_CB_READONLY);
+        if (gpi_trace_enabled()) {
+            gpi_trace_record(GPI_TRACE_INSTANT, "register",
+                             cb_type_to_string(GPI_CB_READONLY), nullptr);
+        }
         return gpi_hdl;
     }
 }
@@ -610,6 +1677,11 @@ gpi_cb_hdl gpi_register_nexttime_callback(int (*gpi_function)(void *),
         LOG_ERROR("Failed to register a nexttime callback");
         return NULL;
     } else {
+        gpi_hdl->set_cb_type(GPI_CB_NEXTTIME);
+        if (gpi_trace_enabled()) {
+            gpi_trace_record(GPI_TRACE_INSTANT, "register",
+                             cb_type_to_string(GPI_CB_NEXTTIME), nullptr);
+        }
         return gpi_hdl;
     }
 }
@@ -624,26 +1696,137 @@ gpi_cb_hdl gpi_register_readwrite_callback(int (*gpi_function)(void *),
         LOG_ERROR("Failed to register a readwrite callback");
         return NULL;
     } else {
+        gpi_hdl->set_cb_type(GPI_CB_READWRITE);
+        if (gpi_trace_enabled()) {
+            gpi_trace_record(GPI_TRACE_INSTANT, "register",
+                             cb_type_to_string(GPI_CB_READWRITE), nullptr);
+        }
         return gpi_hdl;
     }
 }
 
-int gpi_remove_cb(gpi_cb_hdl cb_hdl) { return cb_hdl->remove(); }
+int gpi_remove_cb(gpi_cb_hdl cb_hdl) {
+    if (gpi_trace_enabled()) {
+        gpi_trace_record(GPI_TRACE_INSTANT, "remove",
+                         cb_type_to_string(cb_hdl->get_cb_type()), nullptr);
+    }
+    return cb_hdl->remove();
+}
 
 void gpi_get_cb_info(gpi_cb_hdl cb_hdl, int (**cb_func)(void *),
                      void **cb_data) {
     cb_hdl->get_cb_info(cb_func, cb_data);
 }
 
+static bool fork_enabled = false;
+static void (*fork_prepare_hook)(void) = nullptr;
+static void (*fork_child_hook)(void) = nullptr;
+
+void gpi_enable_fork(void (*prepare)(void), void (*child)(void)) {
+    fork_prepare_hook = prepare;
+    fork_child_hook = child;
+    fork_enabled = true;
+}
+
+long gpi_fork(void) {
+    // Not being able to fork is expected, the caller falls back to running
+    // tests in this process
+#ifdef _WIN32
+    LOG_DEBUG("Forking the simulator is not supported on Windows");
+    return -1;
+#else
+    if (!fork_enabled) {
+        LOG_DEBUG("Simulator does not support forking");
+        return -1;
+    }
+
+    if (fork_prepare_hook) {
+        fork_prepare_hook();
+    }
+    // The log writer thread would not exist in the child
+    if (log_async_enabled) {
+        gpi_native_logger_set_async(false);
+    }
+    // Don't let the child write out anything still buffered a second time
+    fflush(NULL);
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        if (gpi_trace_enabled()) {
+            std::string suffix = "." + std::to_string(getpid());
+            gpi_trace_add_suffix(suffix.c_str());
+        }
+        if (fork_child_hook) {
+            fork_child_hook();
+        }
+    } else if (pid < 0) {
+        // LCOV_EXCL_START
+        LOG_ERROR("Unable to fork the simulator: %s", strerror(errno));
+        // LCOV_EXCL_STOP
+    }
+
+    if (log_async_enabled) {
+        gpi_native_logger_set_async(true);
+    }
+    return static_cast<long>(pid);
+#endif
+}
+
+static int (*checkpoint_save_hook)(const char *) = nullptr;
+
+void gpi_enable_checkpoint(int (*save)(const char *filename)) {
+    checkpoint_save_hook = save;
+}
+
+int gpi_checkpoint_save(const char *filename) {
+    if (!checkpoint_save_hook) {
+        LOG_ERROR("Simulator does not support checkpoints");
+        return -1;
+    }
+    return checkpoint_save_hook(filename);
+}
+
+static int (*waveform_dumping_hook)(bool) = nullptr;
+
+void gpi_enable_waveform_control(int (*set_dumping)(bool enable)) {
+    waveform_dumping_hook = set_dumping;
+}
+
+int gpi_set_waveform_dumping(bool enable) {
+    if (!waveform_dumping_hook) {
+        LOG_ERROR("Simulator does not support waveform control");
+        return -1;
+    }
+    return waveform_dumping_hook(enable);
+}
+
 const char *GpiImplInterface::get_name_c() { return m_name.c_str(); }
 
 const string &GpiImplInterface::get_name_s() { return m_name; }
 
-void gpi_to_user() { LOG_TRACE("Passing control to GPI user"); }
+void gpi_to_user() {
+    auto now = gpi_clock::now();
+    if (!g_in_gpi) {
+        if (g_have_exit) {
+            g_stats.sim_time_ns += elapsed_ns(g_gpi_exit, now);
+        }
+        g_gpi_enter = now;
+        g_in_gpi = true;
+    }
+    GPI_PROBE0(gpi_to_user);
+    LOG_TRACE("Passing control to GPI user");
+}
 
 void gpi_to_simulator() {
     if (sim_ending) {
         gpi_cleanup();
     }
     LOG_TRACE("Returning control to simulator");
+    GPI_PROBE0(gpi_to_simulator);
+    if (g_in_gpi) {
+        g_gpi_exit = gpi_clock::now();
+        g_stats.gpi_time_ns += elapsed_ns(g_gpi_enter, g_gpi_exit);
+        g_have_exit = true;
+        g_in_gpi = false;
+    }
 }
@@ -0,0 +1,536 @@
+// Copyright cocotb contributors
+// Licensed under the Revised BSD License, see LICENSE for details.
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Loading and saving memory image files, see gpi_load_memory()
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cctype>
+#include <cerrno>
+#include <cinttypes>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "gpi.h"
+#include "gpi_priv.h"
+
+namespace {
+
+/* Read-only view of a whole file, memory-mapped where that is supported */
+class MappedFile {
+  public:
+    MappedFile() = default;
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    ~MappedFile();
+
+    bool open(const char *path);
+
+    const uint8_t *data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+  private:
+    const uint8_t *m_data = nullptr;
+    size_t m_size = 0;
+#ifdef _WIN32
+    std::vector<uint8_t> m_buffer;
+#else
+    void *m_map = nullptr;
+#endif
+};
+
+#ifdef _WIN32
+MappedFile::~MappedFile() {}
+
+bool MappedFile::open(const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        LOG_ERROR("Unable to open %s: %s", path, strerror(errno));
+        return false;
+    }
+    uint8_t chunk[65536];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) {
+        m_buffer.insert(m_buffer.end(), chunk, chunk + n);
+    }
+    bool failed = ferror(f) != 0;
+    fclose(f);
+    if (failed) {
+        LOG_ERROR("Unable to read %s", path);
+        return false;
+    }
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+    return true;
+}
+#else
+MappedFile::~MappedFile() {
+    if (m_map) {
+        munmap(m_map, m_size);
+    }
+}
+
+bool MappedFile::open(const char *path) {
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+        LOG_ERROR("Unable to open %s: %s", path, strerror(errno));
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) < 0) {
+        LOG_ERROR("Unable to stat %s: %s", path, strerror(errno));
+        close(fd);
+        return false;
+    }
+    m_size = static_cast<size_t>(st.st_size);
+    if (m_size) {
+        // mmap() of an empty file fails
+        m_map = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (m_map == MAP_FAILED) {
+            LOG_ERROR("Unable to map %s: %s", path, strerror(errno));
+            m_map = nullptr;
+            close(fd);
+            return false;
+        }
+        m_data = static_cast<const uint8_t *>(m_map);
+    }
+    close(fd);
+    return true;
+}
+#endif
+
+/* Consecutive elements of an image, in the layout used by gpi_write_array() */
+struct ImageRun {
+    int64_t addr;  // Image address of the first element
+    size_t count;
+    const uint8_t *data;  // Into the file, or the storage
+    std::vector<uint8_t> storage;
+};
+
+/* Add a run which refers to the file data directly */
+void add_run(std::vector<ImageRun> &runs, int64_t addr, size_t count,
+             const uint8_t *data) {
+    runs.push_back({addr, count, data, {}});
+}
+
+/* Add a run with a copy of *size* bytes, zero-padded to *count* elements */
+void add_run_copy(std::vector<ImageRun> &runs, int64_t addr, size_t count,
+                  size_t elem_size, const uint8_t *data, size_t size) {
+    runs.push_back({addr, count, nullptr, {}});
+    ImageRun &run = runs.back();
+    run.storage.assign(count * elem_size, 0);
+    if (size) {
+        memcpy(run.storage.data(), data, size);
+    }
+    run.data = run.storage.data();
+}
+
+bool parse_bin(const MappedFile &file, size_t elem_size,
+               std::vector<ImageRun> &runs) {
+    size_t whole = file.size() / elem_size;
+    size_t rest = file.size() % elem_size;
+    if (whole) {
+        add_run(runs, 0, whole, file.data());
+    }
+    if (rest) {
+        add_run_copy(runs, static_cast<int64_t>(whole), 1, elem_size,
+                     file.data() + whole * elem_size, rest);
+    }
+    return true;
+}
+
+/* Append the bits of a hex digit, returns false if it isn't one */
+bool append_hex_digit(char c, std::string &bits) {
+    if (c == 'x' || c == 'X') {
+        bits.append(4, 'X');
+    } else if (c == 'z' || c == 'Z' || c == '?') {
+        bits.append(4, 'Z');
+    } else if (isxdigit(static_cast<unsigned char>(c))) {
+        int value = isdigit(static_cast<unsigned char>(c))
+                        ? c - '0'
+                        : tolower(static_cast<unsigned char>(c)) - 'a' + 10;
+        for (int bit = 3; bit >= 0; bit--) {
+            bits.push_back((value >> bit) & 1 ? '1' : '0');
+        }
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/* Parse text in the format read by $readmemh into runs of binary strings */
+bool parse_hex(const MappedFile &file, int width, const char *path,
+               std::vector<ImageRun> &runs) {
+    const char *text = reinterpret_cast<const char *>(file.data());
+    const size_t size = file.size();
+    const size_t elem_size = static_cast<size_t>(width);
+    int line = 1;
+    int64_t addr = 0;
+    size_t count = 0;
+    std::vector<uint8_t> storage;
+    std::string token;
+
+    auto flush = [&]() {
+        if (count) {
+            add_run_copy(runs, addr, count, elem_size, storage.data(),
+                         storage.size());
+            addr += static_cast<int64_t>(count);
+        }
+        count = 0;
+        storage.clear();
+    };
+
+    size_t pos = 0;
+    while (pos < size) {
+        char c = text[pos];
+        if (c == '\n') {
+            line++;
+            pos++;
+            continue;
+        }
+        if (isspace(static_cast<unsigned char>(c))) {
+            pos++;
+            continue;
+        }
+        if (c == '/' && pos + 1 < size && text[pos + 1] == '/') {
+            while (pos < size && text[pos] != '\n') {
+                pos++;
+            }
+            continue;
+        }
+        if (c == '/' && pos + 1 < size && text[pos + 1] == '*') {
+            pos += 2;
+            while (pos < size && !(text[pos] == '*' && pos + 1 < size &&
+                                   text[pos + 1] == '/')) {
+                if (text[pos] == '\n') {
+                    line++;
+                }
+                pos++;
+            }
+            pos += 2;
+            continue;
+        }
+
+        // An address or a data word, up to the next space or comment
+        size_t end = pos + 1;
+        while (end < size && !isspace(static_cast<unsigned char>(text[end])) &&
+               text[end] != '/') {
+            end++;
+        }
+        token.assign(text + pos, end - pos);
+        pos = end;
+
+        if (token[0] == '@') {
+            char *token_end;
+            errno = 0;
+            unsigned long long new_addr =
+                strtoull(token.c_str() + 1, &token_end, 16);
+            if (token.size() == 1 || *token_end || errno ||
+                new_addr > INT64_MAX) {
+                LOG_ERROR("%s:%d: Invalid address '%s'", path, line,
+                          token.c_str());
+                return false;
+            }
+            flush();
+            addr = static_cast<int64_t>(new_addr);
+            continue;
+        }
+
+        std::string bits;
+        for (char digit : token) {
+            if (digit != '_' && !append_hex_digit(digit, bits)) {
+                LOG_ERROR("%s:%d: Invalid hex word '%s'", path, line,
+                          token.c_str());
+                return false;
+            }
+        }
+        // Align on the least significant bit, like $readmemh
+        if (bits.size() > elem_size) {
+            bits.erase(0, bits.size() - elem_size);
+        } else {
+            bits.insert(0, elem_size - bits.size(), '0');
+        }
+        storage.insert(storage.end(), bits.begin(), bits.end());
+        count++;
+    }
+    flush();
+    return true;
+}
+
+uint64_t read_le(const uint8_t *p, int bytes) {
+    uint64_t value = 0;
+    for (int i = bytes - 1; i >= 0; i--) {
+        value = (value << 8) | p[i];
+    }
+    return value;
+}
+
+/* Check that *count* elements at image address *addr* fit in the array */
+bool run_fits(gpi_sim_hdl gpi_hdl, const char *path, int64_t addr,
+              size_t count, int64_t offset) {
+    const int64_t num_elems = gpi_get_num_elems(gpi_hdl);
+    // Addresses past INT64_MAX wrap to negative values. Otherwise the sum can
+    // only overflow for a positive offset.
+    if (addr < 0 ||
+        (offset < 0 ? addr + offset < 0 : addr > INT64_MAX - offset) ||
+        count > static_cast<uint64_t>(INT64_MAX) ||
+        static_cast<int64_t>(count) > num_elems - (addr + offset)) {
+        LOG_ERROR("%s: %zu elements at address 0x%" PRIx64
+                  " are outside of %s",
+                  path, count, static_cast<uint64_t>(addr),
+                  gpi_hdl->get_name_str());
+        return false;
+    }
+    return true;
+}
+
+/* Collect the loadable segments of an ELF file, which must fit in the array
+ * at *array_offset* */
+bool parse_elf(const MappedFile &file, size_t elem_size, const char *path,
+               gpi_sim_hdl gpi_hdl, int64_t array_offset,
+               std::vector<ImageRun> &runs) {
+    const uint8_t *data = file.data();
+    const size_t size = file.size();
+
+    if (size < 52 || memcmp(data, "\x7f" "ELF", 4) != 0) {
+        LOG_ERROR("%s is not an ELF file", path);
+        return false;
+    }
+    const bool is_64 = data[4] == 2;
+    if ((data[4] != 1 && !is_64) || (is_64 && size < 64)) {
+        LOG_ERROR("%s has an invalid ELF class", path);
+        return false;
+    }
+    if (data[5] != 1) {
+        LOG_ERROR("%s: Only little-endian ELF files are supported", path);
+        return false;
+    }
+
+    const uint64_t phoff =
+        is_64 ? read_le(data + 32, 8) : read_le(data + 28, 4);
+    const uint64_t phentsize = read_le(data + (is_64 ? 54 : 42), 2);
+    const uint64_t phnum = read_le(data + (is_64 ? 56 : 44), 2);
+    if (phentsize < (is_64 ? 56u : 32u) || phoff > size ||
+        phnum * phentsize > size - phoff) {
+        LOG_ERROR("%s has an invalid program header table", path);
+        return false;
+    }
+
+    for (uint64_t i = 0; i < phnum; i++) {
+        const uint8_t *ph = data + phoff + i * phentsize;
+        const uint64_t PT_LOAD = 1;
+        if (read_le(ph, 4) != PT_LOAD) {
+            continue;
+        }
+        uint64_t offset, paddr, filesz, memsz;
+        if (is_64) {
+            offset = read_le(ph + 8, 8);
+            paddr = read_le(ph + 24, 8);
+            filesz = read_le(ph + 32, 8);
+            memsz = read_le(ph + 40, 8);
+        } else {
+            offset = read_le(ph + 4, 4);
+            paddr = read_le(ph + 12, 4);
+            filesz = read_le(ph + 16, 4);
+            memsz = read_le(ph + 20, 4);
+        }
+        if (!memsz) {
+            continue;
+        }
+        if (offset > size || filesz > size - offset || filesz > memsz) {
+            LOG_ERROR("%s: Segment %" PRIu64 " is outside the file", path, i);
+            return false;
+        }
+        if (paddr % elem_size) {
+            LOG_ERROR("%s: Segment %" PRIu64 " at 0x%" PRIx64
+                      " is not aligned on %zu-byte elements",
+                      path, i, paddr, elem_size);
+            return false;
+        }
+
+        // Uninitialised data past the end of the file data is zeroed, so
+        // check the segment fits before allocating it
+        const int64_t addr = static_cast<int64_t>(paddr / elem_size);
+        const size_t count =
+            static_cast<size_t>((memsz + elem_size - 1) / elem_size);
+        if (!run_fits(gpi_hdl, path, addr, count, array_offset)) {
+            return false;
+        }
+        if (filesz == memsz && memsz % elem_size == 0) {
+            add_run(runs, addr, count, data + offset);
+        } else {
+            add_run_copy(runs, addr, count, elem_size, data + offset,
+                         static_cast<size_t>(filesz));
+        }
+    }
+    return true;
+}
+
+/* Index of the element at *position* from the left bound */
+int element_at(gpi_sim_hdl gpi_hdl, int64_t position) {
+    const int left = gpi_get_range_left(gpi_hdl);
+    const int pos = static_cast<int>(position);
+    return gpi_get_range_dir(gpi_hdl) == GPI_RANGE_DOWN ? left - pos
+                                                        : left + pos;
+}
+
+}  // namespace
+
+int gpi_load_memory(gpi_sim_hdl gpi_hdl, const char *path,
+                    gpi_mem_format format, int64_t offset) {
+    const int width = gpi_get_array_element_width(gpi_hdl);
+    if (width < 0) {
+        LOG_ERROR("Unable to load %s: %s is not an array of signals", path,
+                  gpi_hdl->get_name_str());
+        return -1;
+    }
+
+    MappedFile file;
+    if (!file.open(path)) {
+        return -1;
+    }
+
+    std::vector<ImageRun> runs;
+    gpi_array_format array_format = GPI_ARRAY_UINT;
+    bool ok;
+    switch (format) {
+        case GPI_MEM_BIN:
+            ok = parse_bin(file, gpi_array_element_size(width, array_format),
+                           runs);
+            break;
+        case GPI_MEM_HEX:
+            array_format = GPI_ARRAY_BINSTR;
+            ok = parse_hex(file, width, path, runs);
+            break;
+        case GPI_MEM_ELF:
+            ok = parse_elf(file, gpi_array_element_size(width, array_format),
+                           path, gpi_hdl, offset, runs);
+            break;
+        default:
+            LOG_ERROR("Unknown memory image format %d", format);
+            return -1;
+    }
+    if (!ok) {
+        return -1;
+    }
+
+    // Check the whole image fits before writing any of it
+    for (const auto &run : runs) {
+        if (!run_fits(gpi_hdl, path, run.addr, run.count, offset)) {
+            return -1;
+        }
+    }
+
+    size_t count = 0;
+    for (const auto &run : runs) {
+        if (gpi_write_array(gpi_hdl, element_at(gpi_hdl, run.addr + offset),
+                            static_cast<int>(run.count), array_format,
+                            run.data, GPI_NO_DELAY)) {
+            return -1;
+        }
+        count += run.count;
+    }
+    LOG_DEBUG("Loaded %zu elements of %s from %s", count,
+              gpi_hdl->get_name_str(), path);
+    return 0;
+}
+
+int gpi_dump_memory(gpi_sim_hdl gpi_hdl, const char *path,
+                    gpi_mem_format format, int64_t offset) {
+    const int width = gpi_get_array_element_width(gpi_hdl);
+    if (width < 0) {
+        LOG_ERROR("Unable to dump %s: %s is not an array of signals", path,
+                  gpi_hdl->get_name_str());
+        return -1;
+    }
+    if (format != GPI_MEM_BIN && format != GPI_MEM_HEX) {
+        LOG_ERROR("Memory images can only be dumped as BIN or HEX");
+        return -1;
+    }
+    if (format == GPI_MEM_BIN && offset != 0) {
+        // BIN images have no addresses, so always start at address 0
+        LOG_ERROR("BIN images can't be dumped with an offset");
+        return -1;
+    }
+    if (format == GPI_MEM_HEX && offset > 0) {
+        LOG_ERROR("The first element of %s has a negative address",
+                  gpi_hdl->get_name_str());
+        return -1;
+    }
+
+    const gpi_array_format array_format =
+        format == GPI_MEM_BIN ? GPI_ARRAY_UINT : GPI_ARRAY_BINSTR;
+    const int num_elems = gpi_get_num_elems(gpi_hdl);
+    const size_t elem_size = gpi_array_element_size(width, array_format);
+    std::vector<uint8_t> elems(static_cast<size_t>(num_elems) * elem_size);
+    if (num_elems &&
+        gpi_read_array(gpi_hdl, gpi_get_range_left(gpi_hdl), num_elems,
+                       array_format, elems.data())) {
+        return -1;
+    }
+
+    std::string text;
+    if (format == GPI_MEM_HEX) {
+        // One word per line, with digits which aren't all 0 and 1 shown as
+        // x, or z if they are all Z
+        const size_t digits = (elem_size + 3) / 4;
+        text.reserve(static_cast<size_t>(num_elems) * (digits + 1) + 20);
+        if (offset) {
+            char addr[20];
+            snprintf(addr, sizeof(addr), "@%" PRIx64 "\n",
+                     static_cast<uint64_t>(-offset));
+            text += addr;
+        }
+        for (int i = 0; i < num_elems; i++) {
+            const char *bits = reinterpret_cast<const char *>(
+                elems.data() + static_cast<size_t>(i) * elem_size);
+            for (size_t digit = 0; digit < digits; digit++) {
+                // The first digit may have fewer than 4 bits
+                const size_t last = elem_size - (digits - 1 - digit) * 4;
+                const size_t first = last >= 4 ? last - 4 : 0;
+                int value = 0;
+                int num_z = 0;
+                bool known = true;
+                for (size_t bit = first; bit < last; bit++) {
+                    value = (value << 1) | (bits[bit] == '1');
+                    num_z += bits[bit] == 'Z';
+                    known = known && (bits[bit] == '0' || bits[bit] == '1');
+                }
+                if (known) {
+                    text += "0123456789abcdef"[value];
+                } else if (num_z == static_cast<int>(last - first)) {
+                    text += 'z';
+                } else {
+                    text += 'x';
+                }
+            }
+            text += '\n';
+        }
+    }
+
+    FILE *f = fopen(path, format == GPI_MEM_BIN ? "wb" : "w");
+    if (!f) {
+        LOG_ERROR("Unable to open %s: %s", path, strerror(errno));
+        return -1;
+    }
+    const void *out = format == GPI_MEM_BIN
+                          ? static_cast<const void *>(elems.data())
+                          : static_cast<const void *>(text.data());
+    const size_t size = format == GPI_MEM_BIN ? elems.size() : text.size();
+    bool failed = size && fwrite(out, 1, size, f) != size;
+    failed = fclose(f) != 0 || failed;
+    if (failed) {
+        LOG_ERROR("Unable to write %s: %s", path, strerror(errno));
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,153 @@
+// Copyright cocotb contributors
+// Licensed under the Revised BSD License, see LICENSE for details.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "GpiTrace.h"
+
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "gpi.h"
+
+namespace {
+
+struct TraceRecord {
+    uint64_t wall_ns;
+    uint64_t sim_time;
+    const char *category;
+    const char *name;
+    const char *detail;
+    gpi_trace_phase phase;
+};
+
+using trace_clock = std::chrono::steady_clock;
+
+std::vector<TraceRecord> records;
+std::atomic<size_t> next_record(0);
+std::string trace_filename;
+trace_clock::time_point trace_start;
+
+// Copies of the details, which may name objects freed before the flush
+std::unordered_set<std::string> details;
+std::mutex details_mutex;
+
+const char *keep_detail(const char *detail) {
+    if (!detail) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(details_mutex);
+    return details.emplace(detail).first->c_str();
+}
+
+void write_json_string(FILE *f, const char *str) {
+    fputc('"', f);
+    for (; *str; str++) {
+        unsigned char c = static_cast<unsigned char>(*str);
+        if (c == '"' || c == '\\') {
+            fputc('\\', f);
+            fputc(c, f);
+        } else if (c < 0x20) {
+            fprintf(f, "\\u%04x", c);
+        } else {
+            fputc(c, f);
+        }
+    }
+    fputc('"', f);
+}
+
+}  // namespace
+
+bool gpi_trace_on = false;
+
+void gpi_trace_open(const char *filename, size_t capacity) {
+    trace_filename = filename;
+    records.resize(capacity);
+    next_record.store(0);
+    trace_start = trace_clock::now();
+    gpi_trace_on = true;
+}
+
+void gpi_trace_record(gpi_trace_phase phase, const char *category,
+                      const char *name, const char *detail) {
+    size_t idx = next_record.fetch_add(1, std::memory_order_relaxed);
+    if (idx >= records.size()) {
+        return;
+    }
+
+    TraceRecord &rec = records[idx];
+    rec.wall_ns = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            trace_clock::now() - trace_start)
+            .count());
+    rec.sim_time = 0;
+    if (gpi_has_registered_impl()) {
+        uint32_t high, low;
+        gpi_get_sim_time(&high, &low);
+        rec.sim_time = (static_cast<uint64_t>(high) << 32) | low;
+    }
+    rec.category = category;
+    rec.name = name;
+    rec.detail = keep_detail(detail);
+    rec.phase = phase;
+}
+
+void gpi_trace_add_suffix(const char *suffix) { trace_filename += suffix; }
+
+void gpi_trace_flush() {
+    if (!gpi_trace_on) {
+        return;
+    }
+    gpi_trace_on = false;
+
+    size_t count = next_record.load();
+    size_t dropped = 0;
+    if (count > records.size()) {
+        dropped = count - records.size();
+        count = records.size();
+    }
+
+    FILE *f = fopen(trace_filename.c_str(), "w");
+    if (!f) {
+        // LCOV_EXCL_START
+        LOG_ERROR("Unable to open trace file %s", trace_filename.c_str());
+        return;
+        // LCOV_EXCL_STOP
+    }
+
+    fprintf(f, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    for (size_t i = 0; i < count; i++) {
+        const TraceRecord &rec = records[i];
+        fprintf(f, "%s{\"ph\":\"%c\",\"pid\":1,\"tid\":1,\"ts\":%" PRIu64
+                   ".%03" PRIu64 ",\"cat\":",
+                i ? ",\n" : "", static_cast<char>(rec.phase),
+                rec.wall_ns / 1000, rec.wall_ns % 1000);
+        write_json_string(f, rec.category);
+        fprintf(f, ",\"name\":");
+        write_json_string(f, rec.name);
+        if (rec.phase == GPI_TRACE_INSTANT) {
+            fprintf(f, ",\"s\":\"t\"");
+        }
+        fprintf(f, ",\"args\":{\"sim_time\":%" PRIu64, rec.sim_time);
+        if (rec.detail) {
+            fprintf(f, ",\"detail\":");
+            write_json_string(f, rec.detail);
+        }
+        fprintf(f, "}}");
+    }
+    fprintf(f, "\n],\"otherData\":{\"dropped_events\":%zu}}\n", dropped);
+    fclose(f);
+
+    if (dropped) {
+        LOG_WARN("Trace buffer full, %zu events were dropped from %s", dropped,
+                 trace_filename.c_str());
+    }
+
+    std::vector<TraceRecord>().swap(records);
+    std::unordered_set<std::string>().swap(details);
+}
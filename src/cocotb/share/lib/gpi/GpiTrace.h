@@ -0,0 +1,59 @@
+// Copyright cocotb contributors
+// Licensed under the Revised BSD License, see LICENSE for details.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef COCOTB_GPI_TRACE_H_
+#define COCOTB_GPI_TRACE_H_
+
+#include <cstddef>
+
+/* Timeline recorder for GPI activity
+ *
+ * When enabled with GPI_TRACE_FILE, every callback entry and exit, callback
+ * registration and removal, and signal value access is appended to a
+ * preallocated in-memory buffer. The buffer is written out as a Chrome
+ * trace-event JSON file (loadable in Perfetto or chrome://tracing) when the
+ * simulation ends.
+ */
+
+/** Trace event phases, matching the Chrome trace-event format. */
+enum gpi_trace_phase : char {
+    GPI_TRACE_BEGIN = 'B',
+    GPI_TRACE_END = 'E',
+    GPI_TRACE_INSTANT = 'i',
+};
+
+extern bool gpi_trace_on;
+
+/** Whether events are currently being recorded. */
+static inline bool gpi_trace_enabled() { return gpi_trace_on; }
+
+/** Start recording, writing to filename once gpi_trace_flush() is called.
+ *
+ * @param filename  Output file.
+ * @param capacity  Maximum number of events to keep, later events are dropped.
+ */
+void gpi_trace_open(const char *filename, size_t capacity);
+
+/** Record an event.
+ *
+ * The category and name must outlive the recorder, until gpi_trace_flush()
+ * is called. The detail is copied.
+ *
+ * @param phase     Event phase.
+ * @param category  Event category, e.g. "callback" or "signal".
+ * @param name      Event name.
+ * @param detail    Extra detail such as a signal name, or NULL.
+ */
+void gpi_trace_record(gpi_trace_phase phase, const char *category,
+                      const char *name, const char *detail);
+
+/** Append suffix to the output file name, e.g. to give forked children their
+ * own trace file.
+ */
+void gpi_trace_add_suffix(const char *suffix);
+
+/** Write out all recorded events and stop recording. */
+void gpi_trace_flush();
+
+#endif /* COCOTB_GPI_TRACE_H_ */
@@ -16,7 +16,10 @@
 #include <embed.h>
 #include <gpi.h>
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 class GpiCbHdl;
 class GpiImplInterface;
@@ -60,7 +63,11 @@ class GPI_EXPORT GpiObjHdl : public GpiHdl {
               gpi_objtype objtype = GPI_UNKNOWN, bool is_const = false)
         : GpiHdl(impl, hdl), m_type(objtype), m_const(is_const) {}
 
-    virtual ~GpiObjHdl() = default;
+    virtual ~GpiObjHdl();
+
+    // Account for the memory used by handles, see gpi_get_memory_stats()
+    static void *operator new(std::size_t size);
+    static void operator delete(void *ptr, std::size_t size);
 
     // TODO why do these even exist? Just return the string by ref and call
     // c_str.
@@ -74,37 +81,114 @@ class GPI_EXPORT GpiObjHdl : public GpiHdl {
     int get_range_right() { return m_range_right; }
     gpi_range_dir get_range_dir() { return m_range_dir; }
     int get_indexable() { return m_indexable; }
+    void *get_user_data() { return m_user_data; }
+    void set_user_data(void *user_data) { m_user_data = user_data; }
+
+    // References handed out by the GPI, dropped by gpi_release_handle()
+    void retain() { ++m_refcount; }
+    bool release() { return --m_refcount == 0; }
+
+    /* Attach the object to the parent it was found through.
+     *
+     * The full name is then stored relative to the parent's, which the object
+     * keeps alive. Called once the object is initialised.
+     */
+    void set_parent(GpiObjHdl *parent);
+    GpiObjHdl *get_parent() { return m_parent; }
+
+    /* The full name is the full name of get_fullname_parent() followed by
+     * get_fullname_part(), or only the latter if there is no such parent.
+     * Both are fixed once the object is attached with set_parent().
+     */
+    GpiObjHdl *get_fullname_parent() const {
+        return m_fullname_relative ? m_parent : nullptr;
+    }
+    const std::string *get_fullname_part() const { return m_fullname_part; }
+
+    // Pseudo-objects can share the simulator handle of their parent. They
+    // must not free the handle themselves.
+    bool shares_handle() const { return m_shares_handle; }
+    void set_shares_handle() { m_shares_handle = true; }
 
     const std::string &get_name();
-    const std::string &get_fullname();
+    std::string get_fullname();
 
-    virtual const char *get_definition_name() {
-        return m_definition_name.c_str();
-    };
-    virtual const char *get_definition_file() {
-        return m_definition_file.c_str();
-    };
+    virtual const char *get_definition_name();
+    virtual const char *get_definition_file();
 
     bool is_native_impl(GpiImplInterface *impl);
     virtual int initialise(const std::string &name,
                            const std::string &full_name);
 
+    /* Bulk access to the elements of an array, see gpi_read_array().
+     *
+     * The range of *first* and *count* has already been checked. The default
+     * implementations go through a temporary object for each element,
+     * implementations override them to access the elements directly.
+     */
+    virtual int get_element_width();
+    virtual int read_elements(int first, int count, gpi_array_format format,
+                              uint8_t *buffer);
+    virtual int write_elements(int first, int count, gpi_array_format format,
+                               const uint8_t *buffer, gpi_set_action action);
+
+  protected:
+    // Index of the element *offset* positions after *first* along the range
+    int element_index(int first, int offset) const {
+        return m_range_dir == GPI_RANGE_DOWN ? first - offset : first + offset;
+    }
+
+    void set_definition_name(const char *name);
+    void set_definition_file(const char *file);
+    bool has_definition_name() const { return m_definition_name != nullptr; }
+    bool has_definition_file() const { return m_definition_file != nullptr; }
+
+    // Names are interned with gpi_intern_string(), so objects with the same
+    // name or definition share one copy
+    const std::string *m_name = nullptr;
+    const std::string *m_definition_name = nullptr;
+    const std::string *m_definition_file = nullptr;
+
+  private:
+    // Interned name relative to the parent's full name, or the full name
+    const std::string *m_fullname_part = nullptr;
+    // Full name until the object is attached with set_parent(), and then
+    // once get_fullname_str() has been called for a relative name
+    std::string *m_fullname = nullptr;
+    GpiObjHdl *m_parent = nullptr;
+
   protected:
+    void *m_user_data = nullptr;
+
     int m_num_elems = 0;
-    bool m_indexable = false;
     int m_range_left = -1;
     int m_range_right = -1;
     gpi_range_dir m_range_dir = GPI_RANGE_NO_DIR;
-    std::string m_name = "unknown";
-    std::string m_fullname = "unknown";
-
-    std::string m_definition_name;
-    std::string m_definition_file;
-
     gpi_objtype m_type;
+    unsigned m_refcount = 0;
+
+    bool m_indexable = false;
     bool m_const;
+    bool m_shares_handle = false;
+    bool m_fullname_relative = false;
 };
 
+/** Get the shared copy of a string.
+ *
+ * Interned strings are never freed, the pointer is valid until the GPI is
+ * unloaded.
+ */
+GPI_EXPORT const std::string *gpi_intern_string(const std::string &str);
+
+/* Conversions between binary strings and the element formats used by
+ * gpi_read_array() and gpi_write_array()
+ */
+GPI_EXPORT size_t gpi_array_element_size(int width, gpi_array_format format);
+GPI_EXPORT void gpi_binstr_to_element(const char *binstr, int width,
+                                      gpi_array_format format, uint8_t *elem);
+GPI_EXPORT std::string gpi_element_to_binstr(const uint8_t *elem, int width,
+                                             gpi_array_format format);
+
 /* GPI Signal object handle, maps to a simulation object */
 //
 // Identical to an object but adds additional methods for getting/setting the
@@ -113,7 +197,7 @@ class GPI_EXPORT GpiSignalObjHdl : public GpiObjHdl {
   public:
     using GpiObjHdl::GpiObjHdl;
 
-    virtual ~GpiSignalObjHdl() = default;
+    virtual ~GpiSignalObjHdl();
     // Provide public access to the implementation (composition vs inheritance)
     virtual const char *get_signal_value_binstr() = 0;
     virtual const char *get_signal_value_str() = 0;
@@ -135,6 +219,56 @@ class GPI_EXPORT GpiSignalObjHdl : public GpiObjHdl {
 
     virtual GpiCbHdl *register_value_change_callback(
         gpi_edge edge, int (*gpi_function)(void *), void *gpi_cb_data) = 0;
+
+    /* Bit slices of vectors, see gpi_get_signal_slice().
+     *
+     * *first* is the position of the leftmost bit of the slice from the left
+     * of the vector, and has already been checked along with the length of
+     * *value*. The default implementations go through the value of the whole
+     * vector.
+     */
+    virtual int get_signal_slice_binstr(int first, int count,
+                                        std::string &value);
+    virtual int set_signal_slice_binstr(int first, const std::string &value,
+                                        gpi_set_action action);
+
+    /* Last value deposited, see gpi_set_write_elision().
+     *
+     * Allocated on the first deposit while write elision is enabled.
+     */
+    struct WriteShadow;
+    WriteShadow *m_write_shadow = nullptr;
+};
+
+/* Bit mask and target value filtering a value change callback, see
+ * gpi_register_masked_value_change_callback()
+ */
+class GPI_EXPORT GpiValueFilter {
+  public:
+    /* Watch the bits set in *mask* of a signal which currently has the value
+     * *current*. *target* is the value the watched bits must reach, or NULL to
+     * report any change of them.
+     */
+    void set(const char *mask, const char *target, const char *current);
+    /* Report every change to *group* as a change of its member *member*
+     * instead, so the callback never fires and stays registered.
+     */
+    void set_group(GpiCbGroup *group, int member);
+    void clear();
+    bool active() const { return m_width != 0 || m_group; }
+
+    /* Whether the change of the signal to *binstr* is reported */
+    bool pass(const char *binstr);
+    /* Whether the change of *signal* is reported */
+    bool pass(GpiSignalObjHdl *signal);
+
+  private:
+    size_t m_width = 0;
+    std::vector<size_t> m_bits;  // Positions of the watched bits
+    std::string m_target;        // Target of the watched bits, may be empty
+    std::string m_last;          // Last seen value of the watched bits
+    GpiCbGroup *m_group = nullptr;
+    int m_member = -1;
 };
 
 /* GPI Callback handle */
@@ -188,9 +322,69 @@ class GPI_EXPORT GpiCbHdl : public GpiHdl {
      */
     virtual int run() = 0;
 
+    /** Set the category used when accounting statistics for this callback.
+     */
+    void set_cb_type(gpi_cb_type cb_type) noexcept { m_cb_type = cb_type; }
+
+    gpi_cb_type get_cb_type() const noexcept { return m_cb_type; }
+
+    /** Mark the callback as used by the GPI itself.
+     *
+     * Internal callbacks are called directly, without being batched,
+     * accounted in statistics or traced.
+     */
+    void set_internal() noexcept { m_internal = true; }
+
+    /** Get the filter of a value change callback, NULL for other callbacks.
+     */
+    virtual GpiValueFilter *get_value_filter() { return nullptr; }
+
   protected:
+    /** Call the user callback function, accounting the time spent in it.
+     *
+     * Implementations should use this from run() rather than calling
+     * m_cb_func directly.
+     */
+    int call_cb_func();
+
     int (*m_cb_func)(void *);  // GPI function to callback
     void *m_cb_data;           // GPI data supplied to "m_cb_func"
+    gpi_cb_type m_cb_type = GPI_CB_OTHER;
+    bool m_internal = false;
+};
+
+/* Value change callbacks on a set of signals, see gpi_create_cb_group() */
+class GPI_EXPORT GpiCbGroup {
+  public:
+    GpiCbGroup(int (*cb_func)(void *), void *cb_data)
+        : m_cb_func(cb_func), m_cb_data(cb_data) {}
+    ~GpiCbGroup();
+
+    int add(GpiSignalObjHdl *signal);
+    int remove(int member);
+    void set_armed(bool armed);
+    const std::vector<int> &get_changed() const { return m_fired; }
+
+    /* Called by the value change callback of *member* */
+    void member_changed(int member);
+
+  private:
+    struct Member {
+        GpiSignalObjHdl *signal;
+        GpiCbHdl *cb;
+        bool changed;
+    };
+
+    static int fire(void *group);
+
+    int (*m_cb_func)(void *);
+    void *m_cb_data;
+    std::vector<Member> m_members;  // By identifier, NULL signal if free
+    std::vector<int> m_free;        // Identifiers to reuse
+    std::vector<int> m_changed;     // Changed since armed
+    std::vector<int> m_fired;       // Changed before last firing
+    GpiCbHdl *m_fire_cb = nullptr;  // ReadWrite callback firing the group
+    bool m_armed = false;
 };
 
 class GPI_EXPORT GpiIterator : public GpiHdl {
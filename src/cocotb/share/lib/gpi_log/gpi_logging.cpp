@@ -6,10 +6,18 @@
 
 #include "gpi_logging.h"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdarg>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
 #include <vector>
 
 #include "cocotb_utils.h"  // DEFER
@@ -54,6 +62,8 @@ extern "C" void gpi_set_log_handler(gpi_log_handler_ftype handler,
                                     gpi_log_filter_ftype filter,
                                     gpi_log_set_level_ftype set_level,
                                     void *userdata) {
+    // keep ordering with anything still queued in the native logger
+    gpi_native_logger_flush();
     current_handler = handler;
     current_filter = filter;
     current_set_level = set_level;
@@ -104,6 +114,119 @@ extern "C" const char *gpi_log_level_to_str(int level) {
  *******************************************************************************/
 
 static int current_native_logger_level = GPI_NOTSET;
+static gpi_native_logger_sim_time_ftype current_sim_time_func = nullptr;
+
+/* Asynchronous sink
+ *
+ * Formatted lines are pushed into a single-producer single-consumer ring of
+ * fixed size slots and written out in batches by a background thread. All
+ * GPI logging happens on the simulator thread, which is the only producer.
+ * Lines which don't fit in a slot are written synchronously after draining the
+ * ring, so ordering is preserved. The writer polls the ring, and is only woken
+ * early once enough lines are queued to be worth a batch.
+ */
+namespace {
+
+constexpr size_t ASYNC_SLOT_SIZE = 512;
+constexpr size_t ASYNC_NUM_SLOTS = 4096;
+constexpr size_t ASYNC_FLUSH_THRESHOLD = ASYNC_NUM_SLOTS / 4;
+
+struct AsyncSlot {
+    size_t len;
+    char data[ASYNC_SLOT_SIZE];
+};
+
+class AsyncLogSink {
+  public:
+    bool start() {
+        if (m_running) {
+            return true;
+        }
+        m_slots.reset(new (std::nothrow) AsyncSlot[ASYNC_NUM_SLOTS]);
+        if (!m_slots) {
+            return false;  // LCOV_EXCL_LINE
+        }
+        m_stop.store(false);
+        m_thread = std::thread(&AsyncLogSink::writer, this);
+        m_running = true;
+        return true;
+    }
+
+    void stop() {
+        if (!m_running) {
+            return;
+        }
+        m_stop.store(true, std::memory_order_release);
+        m_cv.notify_one();
+        m_thread.join();
+        m_running = false;
+    }
+
+    bool running() const { return m_running; }
+
+    /* Returns a slot to format into, or nullptr if the ring is full. */
+    AsyncSlot *reserve() {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) >= ASYNC_NUM_SLOTS) {
+            return nullptr;
+        }
+        return &m_slots[head % ASYNC_NUM_SLOTS];
+    }
+
+    void commit() {
+        size_t head = m_head.fetch_add(1, std::memory_order_release) + 1;
+        if (head - m_tail.load(std::memory_order_relaxed) ==
+            ASYNC_FLUSH_THRESHOLD) {
+            m_cv.notify_one();
+        }
+    }
+
+    /* Block until the writer thread has written out everything queued. */
+    void drain() {
+        while (m_tail.load(std::memory_order_acquire) !=
+               m_head.load(std::memory_order_relaxed)) {
+            m_cv.notify_one();
+            std::this_thread::yield();
+        }
+    }
+
+  private:
+    void writer() {
+        while (true) {
+            size_t tail = m_tail.load(std::memory_order_relaxed);
+            size_t head = m_head.load(std::memory_order_acquire);
+            if (tail == head) {
+                if (m_stop.load(std::memory_order_acquire)) {
+                    break;
+                }
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cv.wait_for(lock, std::chrono::milliseconds(10));
+                continue;
+            }
+            for (; tail != head; tail++) {
+                const AsyncSlot &slot = m_slots[tail % ASYNC_NUM_SLOTS];
+                fwrite(slot.data, 1, slot.len, stdout);
+            }
+            fflush(stdout);
+            m_tail.store(tail, std::memory_order_release);
+        }
+    }
+
+    std::unique_ptr<AsyncSlot[]> m_slots;
+    std::atomic<size_t> m_head{0};
+    std::atomic<size_t> m_tail{0};
+    std::atomic<bool> m_stop{false};
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::thread m_thread;
+    bool m_running = false;
+};
+
+AsyncLogSink async_sink;
+
+void stop_async_sink() { async_sink.stop(); }
+
+}  // namespace
 
 extern "C" void gpi_native_logger_log_(const char *name, int level,
                                        const char *pathname,
@@ -115,6 +238,34 @@ extern "C" void gpi_native_logger_log_(const char *name, int level,
     va_end(argp);
 }
 
+/* Format the sim time column, this must always be 12 characters.
+ *
+ * The unit grows with the time so that the value fits in the column.
+ */
+static void format_sim_time(char (&buf)[32]) {
+    // the time function may log if the simulator complains, so guard against
+    // recursing back into it
+    static bool in_time_func = false;
+
+    double time_ns;
+    if (current_sim_time_func && !in_time_func) {
+        in_time_func = true;
+        bool ok = current_sim_time_func(&time_ns);
+        in_time_func = false;
+        if (ok) {
+            static const char *const units[] = {"ns", "us", "ms", " s"};
+            size_t unit = 0;
+            while (time_ns >= 999999.995 && unit < 3) {
+                time_ns /= 1000;
+                unit++;
+            }
+            snprintf(buf, sizeof(buf), "%9.2f%s ", time_ns, units[unit]);
+            return;
+        }
+    }
+    snprintf(buf, sizeof(buf), "     -.--ns ");
+}
+
 extern "C" void gpi_native_logger_vlog_(const char *name, int level,
                                         const char *pathname,
                                         const char *funcname, long lineno,
@@ -168,22 +319,48 @@ extern "C" void gpi_native_logger_vlog_(const char *name, int level,
         }
     }
 
-    fprintf(stdout, "     -.--ns ");
-    fprintf(stdout, "%-9s", gpi_log_level_to_str(level));
-    fprintf(stdout, "%-35s", name);
+    char time_buff[32];
+    format_sim_time(time_buff);
 
     size_t pathlen = strlen(pathname);
+    const char *path_prefix = "";
     if (pathlen > 20) {
-        fprintf(stdout, "..%18s:", (pathname + (pathlen - 18)));
-    } else {
-        fprintf(stdout, "%20s:", pathname);
+        path_prefix = "..";
+        pathname += pathlen - 18;
     }
 
-    fprintf(stdout, "%-4ld", lineno);
-    fprintf(stdout, " in %-31s ", funcname);
-    fprintf(stdout, "%s", log_buff.data());
-    fprintf(stdout, "\n");
+#define NATIVE_LOG_FMT "%s%-9s%-35s%s%*s:%-4ld in %-31s %s\n"
+#define NATIVE_LOG_ARGS                                                 \
+    time_buff, gpi_log_level_to_str(level), name, path_prefix,          \
+        (pathlen > 20 ? 18 : 20), pathname, lineno, funcname, log_buff.data()
+
+    if (async_sink.running()) {
+        AsyncSlot *slot = async_sink.reserve();
+        while (!slot) {
+            // ring is full, wait for the writer to catch up
+            async_sink.drain();
+            slot = async_sink.reserve();
+        }
+        int len = snprintf(slot->data, ASYNC_SLOT_SIZE, NATIVE_LOG_FMT,
+                           NATIVE_LOG_ARGS);
+        if (len >= 0 && static_cast<size_t>(len) < ASYNC_SLOT_SIZE) {
+            slot->len = static_cast<size_t>(len);
+            async_sink.commit();
+            if (level >= GPI_CRITICAL) {
+                // The simulator is likely about to go down
+                async_sink.drain();
+            }
+            return;
+        }
+        // too long for a slot, write it directly once the queue is empty
+        async_sink.drain();
+    }
+
+    fprintf(stdout, NATIVE_LOG_FMT, NATIVE_LOG_ARGS);
     fflush(stdout);
+
+#undef NATIVE_LOG_FMT
+#undef NATIVE_LOG_ARGS
 }
 
 extern "C" int gpi_native_logger_set_level(int level) {
@@ -195,3 +372,31 @@ extern "C" int gpi_native_logger_set_level(int level) {
 extern "C" bool gpi_native_logger_filtered(int level) {
     return level >= current_native_logger_level;
 }
+
+extern "C" void gpi_native_logger_set_sim_time_func(
+    gpi_native_logger_sim_time_ftype func) {
+    current_sim_time_func = func;
+}
+
+extern "C" bool gpi_native_logger_set_async(bool enable) {
+    if (enable) {
+        static bool registered = false;
+        if (!async_sink.start()) {
+            return false;  // LCOV_EXCL_LINE
+        }
+        if (!registered) {
+            // make sure everything is written out when the process exits
+            std::atexit(stop_async_sink);
+            registered = true;
+        }
+    } else {
+        async_sink.stop();
+    }
+    return true;
+}
+
+extern "C" void gpi_native_logger_flush(void) {
+    if (async_sink.running()) {
+        async_sink.drain();
+    }
+}
@@ -8,9 +8,10 @@
 
 #include <cstdarg>  // va_list, va_copy, va_end
 #include <cstdio>   // fprintf, vsnprintf
-#include <map>      // std::map
-#include <string>   // std::string
-#include <vector>   // std::vector
+#include <map>            // std::map
+#include <string>         // std::string
+#include <unordered_map>  // std::unordered_map
+#include <vector>         // std::vector
 
 #include "cocotb_utils.h"  // DEFER
 #include "gpi_logging.h"   // all things GPI logging
@@ -18,9 +19,94 @@
 static int py_gpi_log_level = GPI_NOTSET;
 
 static PyObject *m_log_func = nullptr;
-static std::map<std::string, PyObject *> m_logger_map;
 static PyObject *m_get_logger = nullptr;
 
+// Sentinel for a logger whose effective level must be fetched from Python.
+static constexpr int LEVEL_UNKNOWN = -1;
+
+struct LoggerEntry {
+    PyObject *logger;  // owned reference to the logging.Logger
+    int level;  // lowest level the logger emits, or LEVEL_UNKNOWN if stale
+};
+
+// Mirror of the Python loggers' effective levels. This lets messages which
+// Python would drop anyway return before acquiring the GIL or creating any
+// objects. Only touched on the simulator thread, which is also the thread
+// running Python.
+static std::map<std::string, LoggerEntry> m_logger_map;
+
+// Interned pathname and function name strings. The pointers passed to the
+// handler come from __FILE__ and __func__, so they are stable for the
+// lifetime of the program and can be used as keys.
+static std::unordered_map<const char *, PyObject *> m_string_cache;
+
+static PyObject *cached_string(const char *str) {
+    const auto lookup = m_string_cache.find(str);
+    if (lookup != m_string_cache.end()) {
+        return lookup->second;
+    }
+    PyObject *obj = PyUnicode_InternFromString(str);  // New reference
+    if (obj) {
+        m_string_cache[str] = obj;  // steal that ref
+    }
+    return obj;
+}
+
+// Lowest level *logger* will emit, mirroring logging.Logger.isEnabledFor().
+static int fetch_enabled_level(PyObject *logger) {
+    PyObject *level_obj =
+        PyObject_CallMethod(logger, "getEffectiveLevel", NULL);
+    // LCOV_EXCL_START
+    if (!level_obj) {
+        return LEVEL_UNKNOWN;
+    }
+    // LCOV_EXCL_STOP
+    long level = PyLong_AsLong(level_obj);
+    Py_DECREF(level_obj);
+    // LCOV_EXCL_START
+    if (level == -1 && PyErr_Occurred()) {
+        return LEVEL_UNKNOWN;
+    }
+    // LCOV_EXCL_STOP
+
+    // Account for logging.disable()
+    PyObject *manager = PyObject_GetAttrString(logger, "manager");
+    // LCOV_EXCL_START
+    if (!manager) {
+        return LEVEL_UNKNOWN;
+    }
+    // LCOV_EXCL_STOP
+    DEFER(Py_DECREF(manager));
+    PyObject *disable_obj = PyObject_GetAttrString(manager, "disable");
+    // LCOV_EXCL_START
+    if (!disable_obj) {
+        return LEVEL_UNKNOWN;
+    }
+    // LCOV_EXCL_STOP
+    long disable = PyLong_AsLong(disable_obj);
+    Py_DECREF(disable_obj);
+    // LCOV_EXCL_START
+    if (disable == -1 && PyErr_Occurred()) {
+        return LEVEL_UNKNOWN;
+    }
+    // LCOV_EXCL_STOP
+    if (disable >= level) {
+        level = disable + 1;
+    }
+    return static_cast<int>(level);
+}
+
+// Returns true if a message at *level* on *name* is known to be dropped by
+// Python without needing the GIL.
+static bool cached_level_filters(const char *name, int level) {
+    const auto lookup = m_logger_map.find(name);
+    if (lookup == m_logger_map.end()) {
+        return false;
+    }
+    const int enabled_level = lookup->second.level;
+    return enabled_level != LEVEL_UNKNOWN && level < enabled_level;
+}
+
 static void fallback_handler(const char *name, int level, const char *pathname,
                              const char *funcname, long lineno,
                              const char *msg) {
@@ -34,11 +120,15 @@ static void fallback_handler(const char *name, int level, const char *pathname,
 static void py_gpi_log_handler(void *, const char *name, int level,
                                const char *pathname, const char *funcname,
                                long lineno, const char *msg, va_list argp) {
-    // Always pass through messages when NOTSET to let Python make the decision.
-    // Otherwise, skip logs using the local log level for better performance.
+    // Skip logs using the local log level and the cached Python logger levels
+    // for better performance. When the level isn't known yet, pass the message
+    // through to let Python make the decision.
     if (py_gpi_log_level != GPI_NOTSET && level < py_gpi_log_level) {
         return;
     }
+    if (cached_level_filters(name, level)) {
+        return;
+    }
 
     va_list argp_copy;
     va_copy(argp_copy, argp);
@@ -48,6 +138,41 @@ static void py_gpi_log_handler(void *, const char *name, int level,
     PyGILState_STATE gstate = PyGILState_Ensure();
     DEFER(PyGILState_Release(gstate));
 
+    auto lookup = m_logger_map.find(name);
+    if (lookup == m_logger_map.end()) {
+        PyObject *logger =
+            PyObject_CallFunction(m_get_logger, "s", name);  // incs a ref
+        // LCOV_EXCL_START
+        if (!logger) {
+            PyErr_Print();
+            gpi_native_logger_vlog_(name, level, pathname, funcname, lineno,
+                                    msg, argp);
+            gpi_native_logger_log_("gpi", GPI_ERROR, __FILE__, __func__,
+                                   __LINE__,
+                                   "Error calling Python logging function "
+                                   "from C++ while logging the above");
+            return;
+        }
+        // LCOV_EXCL_STOP
+        // steal that ref
+        lookup =
+            m_logger_map.emplace(name, LoggerEntry{logger, LEVEL_UNKNOWN})
+                .first;
+    }
+    PyObject *logger = lookup->second.logger;
+    if (lookup->second.level == LEVEL_UNKNOWN) {
+        lookup->second.level = fetch_enabled_level(logger);
+        // LCOV_EXCL_START
+        if (lookup->second.level == LEVEL_UNKNOWN) {
+            PyErr_Print();
+        }
+        // LCOV_EXCL_STOP
+    }
+    if (lookup->second.level != LEVEL_UNKNOWN &&
+        level < lookup->second.level) {
+        return;
+    }
+
     static std::vector<char> log_buff(512);
 
     log_buff.clear();
@@ -95,23 +220,7 @@ static void py_gpi_log_handler(void *, const char *name, int level,
     }
     DEFER(Py_DECREF(level_arg));
 
-    PyObject *logger;
-    const auto lookup = m_logger_map.find(name);
-    if (lookup == m_logger_map.end()) {
-        logger = PyObject_CallFunction(m_get_logger, "s", name);  // incs a ref
-        // LCOV_EXCL_START
-        if (!logger) {
-            PyErr_Print();
-            return fallback_handler(name, level, pathname, funcname, lineno,
-                                    log_buff.data());
-        }
-        // LCOV_EXCL_STOP
-        m_logger_map[name] = logger;  // steal that ref
-    } else {
-        logger = lookup->second;
-    }
-
-    PyObject *filename_arg = PyUnicode_FromString(pathname);  // New reference
+    PyObject *filename_arg = cached_string(pathname);  // Borrowed reference
     if (filename_arg == NULL) {
         // LCOV_EXCL_START
         PyErr_Print();
@@ -119,7 +228,6 @@ static void py_gpi_log_handler(void *, const char *name, int level,
                                 log_buff.data());
         // LCOV_EXCL_STOP
     }
-    DEFER(Py_DECREF(filename_arg));
 
     PyObject *lineno_arg = PyLong_FromLong(lineno);  // New reference
     if (lineno_arg == NULL) {
@@ -141,7 +249,7 @@ static void py_gpi_log_handler(void *, const char *name, int level,
     }
     DEFER(Py_DECREF(msg_arg));
 
-    PyObject *function_arg = PyUnicode_FromString(funcname);  // New reference
+    PyObject *function_arg = cached_string(funcname);  // Borrowed reference
     if (function_arg == NULL) {
         // LCOV_EXCL_START
         PyErr_Print();
@@ -149,7 +257,6 @@ static void py_gpi_log_handler(void *, const char *name, int level,
                                 log_buff.data());
         // LCOV_EXCL_STOP
     }
-    DEFER(Py_DECREF(function_arg))
 
     // Log function args are logger_name, level, filename, lineno, msg, function
     PyObject *handler_ret = PyObject_CallFunctionObjArgs(
@@ -165,8 +272,8 @@ static void py_gpi_log_handler(void *, const char *name, int level,
     Py_DECREF(handler_ret);
 }
 
-static bool py_gpi_log_filter(void *, const char *, int level) {
-    return level >= py_gpi_log_level;
+static bool py_gpi_log_filter(void *, const char *name, int level) {
+    return level >= py_gpi_log_level && !cached_level_filters(name, level);
 }
 
 static bool py_gpi_logger_set_level(void *, const char *, int level) {
@@ -191,9 +298,19 @@ extern "C" void py_gpi_logger_finalize() {
     Py_XDECREF(m_log_func);
     Py_XDECREF(m_get_logger);
     for (auto &elem : m_logger_map) {
-        Py_DECREF(elem.second);
+        Py_DECREF(elem.second.logger);
     }
     m_logger_map.clear();
+    for (auto &elem : m_string_cache) {
+        Py_DECREF(elem.second);
+    }
+    m_string_cache.clear();
+}
+
+extern "C" void py_gpi_logger_clear_level_cache() {
+    for (auto &elem : m_logger_map) {
+        elem.second.level = LEVEL_UNKNOWN;
+    }
 }
 
 PyObject *pEventFn = NULL;
@@ -14,10 +14,14 @@
 #include <Python.h>
 
 #include <cerrno>
+#include <climits>
 #include <cstdint>
+#include <cstring>
+#include <vector>
 
 #include "cocotb_utils.h"  // to_python to_simulator
 #include "gpi.h"
+#include "gpi_probes.h"
 #include "py_gpi_logging.h"  // py_gpi_logger_set_level
 
 // This file defines the routines available to Python
@@ -56,6 +60,33 @@ struct gpi_hdl_Object {
     static PyTypeObject py_type;
 };
 
+/** Object handles are wrapped at most once, and cache their name */
+template <>
+struct gpi_hdl_Object<gpi_sim_hdl> {
+    PyObject_HEAD gpi_sim_hdl hdl;
+    PyObject *name;  // interned on first use
+
+    static PyTypeObject py_type;
+};
+
+/** Iterators keep the object they iterate over alive */
+template <>
+struct gpi_hdl_Object<gpi_iterator_hdl> {
+    PyObject_HEAD gpi_iterator_hdl hdl;
+    PyObject *parent;  // NULL when iterating over packages
+
+    static PyTypeObject py_type;
+};
+
+/** Callback groups own the callback they were last armed with */
+template <>
+struct gpi_hdl_Object<gpi_cb_group_hdl> {
+    PyObject_HEAD gpi_cb_group_hdl hdl;
+    PythonCallback *cb_data;
+
+    static PyTypeObject py_type;
+};
+
 /** __repr__ shows the memory address of the internal handle */
 template <typename gpi_hdl>
 static PyObject *gpi_hdl_repr(gpi_hdl_Object<gpi_hdl> *self) {
@@ -92,6 +123,70 @@ static PyObject *gpi_hdl_New(gpi_hdl hdl) {
     return (PyObject *)obj;
 }
 
+/**
+ * Object handles are shared by the GPI, so the wrapper is attached to the
+ * handle and the same Python object is returned for as long as it's alive.
+ * The wrapper owns one reference to the handle, which it releases when it is
+ * deallocated.
+ */
+template <>
+PyObject *gpi_hdl_New<gpi_sim_hdl>(gpi_sim_hdl hdl) {
+    if (hdl == NULL) {
+        Py_RETURN_NONE;
+    }
+    auto *obj =
+        static_cast<gpi_hdl_Object<gpi_sim_hdl> *>(gpi_get_user_data(hdl));
+    if (obj) {
+        // the wrapper already holds a reference
+        gpi_release_handle(hdl);
+        Py_INCREF(obj);
+        return (PyObject *)obj;
+    }
+    obj = PyObject_New(gpi_hdl_Object<gpi_sim_hdl>,
+                       &gpi_hdl_Object<gpi_sim_hdl>::py_type);
+    if (obj == NULL) {
+        gpi_release_handle(hdl);
+        return NULL;
+    }
+    obj->hdl = hdl;
+    obj->name = NULL;
+    gpi_set_user_data(hdl, obj);
+    return (PyObject *)obj;
+}
+
+/**
+ * The GPI iterator uses the handle of the object it iterates over, so the
+ * wrapper holds a reference to that object's wrapper.
+ */
+template <>
+PyObject *gpi_hdl_New<gpi_iterator_hdl>(gpi_iterator_hdl hdl) {
+    if (hdl == NULL) {
+        Py_RETURN_NONE;
+    }
+    auto *obj = PyObject_New(gpi_hdl_Object<gpi_iterator_hdl>,
+                             &gpi_hdl_Object<gpi_iterator_hdl>::py_type);
+    if (obj == NULL) {
+        return NULL;
+    }
+    obj->hdl = hdl;
+    obj->parent = NULL;
+    return (PyObject *)obj;
+}
+
+static void gpi_iterator_hdl_dealloc(PyObject *self) {
+    auto *obj = reinterpret_cast<gpi_hdl_Object<gpi_iterator_hdl> *>(self);
+    Py_XDECREF(obj->parent);
+    Py_TYPE(self)->tp_free(self);
+}
+
+static void gpi_sim_hdl_dealloc(PyObject *self) {
+    auto *obj = reinterpret_cast<gpi_hdl_Object<gpi_sim_hdl> *>(self);
+    gpi_set_user_data(obj->hdl, NULL);
+    gpi_release_handle(obj->hdl);
+    Py_XDECREF(obj->name);
+    Py_TYPE(self)->tp_free(self);
+}
+
 /** Comparison checks if the types match, and then compares pointers */
 template <typename gpi_hdl>
 static PyObject *gpi_hdl_richcompare(PyObject *self, PyObject *other, int op) {
@@ -128,10 +223,6 @@ PyTypeObject fill_common_slots() {
 
 // these will be initialized later, once the members are all defined
 template <>
-PyTypeObject gpi_hdl_Object<gpi_sim_hdl>::py_type;
-template <>
-PyTypeObject gpi_hdl_Object<gpi_iterator_hdl>::py_type;
-template <>
 PyTypeObject gpi_hdl_Object<gpi_cb_hdl>::py_type;
 template <>
 PyTypeObject gpi_hdl_Object<gpi_clk_hdl>::py_type;
@@ -139,6 +230,153 @@ PyTypeObject gpi_hdl_Object<gpi_clk_hdl>::py_type;
 
 typedef int (*gpi_function_t)(void *);
 
+/* Argument parsing
+ *
+ * Methods taking arguments use METH_FASTCALL or METH_O rather than
+ * METH_VARARGS, so calling them doesn't build an argument tuple and parse it
+ * against a format string. They are the most frequent calls from Python into
+ * the GPI, so the helpers below do the same conversions as the
+ * PyArg_ParseTuple() format units noted on each.
+ */
+#if PY_VERSION_HEX >= 0x03070000
+#define FASTCALL_PARAMS PyObject *const *args, Py_ssize_t nargs
+#define CHECK_NO_KWNAMES(name)
+#else
+// Before Python 3.7, METH_FASTCALL functions are also passed keyword names
+#define FASTCALL_PARAMS \
+    PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames
+#define CHECK_NO_KWNAMES(name)                                       \
+    if (kwnames && PyTuple_GET_SIZE(kwnames)) {                      \
+        PyErr_SetString(PyExc_TypeError,                             \
+                        name "() takes no keyword arguments");       \
+        return NULL;                                                 \
+    }
+#endif
+
+// Cast through void (*)(void) to silence -Wcast-function-type
+#define FASTCALL_METHOD(func) ((PyCFunction)(void (*)(void))(func))
+
+static bool check_nargs(const char *name, Py_ssize_t nargs, Py_ssize_t min,
+                        Py_ssize_t max) {
+    if (nargs < min || (nargs > max && min == max)) {
+        PyErr_Format(PyExc_TypeError,
+                     "%s() takes %s %zd arguments (%zd given)", name,
+                     min == max ? "exactly" : "at least", min, nargs);
+        return false;
+    }
+    if (nargs > max) {
+        PyErr_Format(PyExc_TypeError,
+                     "%s() takes at most %zd arguments (%zd given)", name, max,
+                     nargs);
+        return false;
+    }
+    return true;
+}
+
+static bool check_not_float(PyObject *arg) {
+    if (PyFloat_Check(arg)) {
+        PyErr_SetString(PyExc_TypeError,
+                        "integer argument expected, got float");
+        return false;
+    }
+    return true;
+}
+
+// "i"
+static bool parse_int(PyObject *arg, int &value) {
+    if (!check_not_float(arg)) {
+        return false;
+    }
+    long result = PyLong_AsLong(arg);
+    if (result == -1 && PyErr_Occurred()) {
+        return false;
+    }
+    if (result > INT_MAX || result < INT_MIN) {
+        PyErr_SetString(PyExc_OverflowError,
+                        "Python int too large to convert to C int");
+        return false;
+    }
+    value = static_cast<int>(result);
+    return true;
+}
+
+// "L"
+static bool parse_long_long(PyObject *arg, long long &value) {
+    if (!check_not_float(arg)) {
+        return false;
+    }
+    value = PyLong_AsLongLong(arg);
+    return !(value == -1 && PyErr_Occurred());
+}
+
+// "K"
+static bool parse_unsigned_long_long_mask(PyObject *arg,
+                                          unsigned long long &value) {
+    if (!check_not_float(arg)) {
+        return false;
+    }
+    if (!PyLong_Check(arg)) {
+        PyErr_Format(PyExc_TypeError, "integer argument expected, got %.50s",
+                     Py_TYPE(arg)->tp_name);
+        return false;
+    }
+    value = PyLong_AsUnsignedLongLongMask(arg);
+    return !(value == (unsigned long long)-1 && PyErr_Occurred());
+}
+
+// "d"
+static bool parse_double(PyObject *arg, double &value) {
+    value = PyFloat_AsDouble(arg);
+    return !(value == -1.0 && PyErr_Occurred());
+}
+
+// "s"
+static bool parse_str(PyObject *arg, const char *&value) {
+    if (!PyUnicode_Check(arg)) {
+        PyErr_Format(PyExc_TypeError, "argument must be str, not %.50s",
+                     Py_TYPE(arg)->tp_name);
+        return false;
+    }
+    Py_ssize_t size;
+    value = PyUnicode_AsUTF8AndSize(arg, &size);
+    if (!value) {
+        return false;
+    }
+    if (strlen(value) != static_cast<size_t>(size)) {
+        PyErr_SetString(PyExc_ValueError, "embedded null character");
+        return false;
+    }
+    return true;
+}
+
+// "y"
+static bool parse_bytes(PyObject *arg, const char *&value) {
+    if (!PyBytes_Check(arg)) {
+        PyErr_Format(PyExc_TypeError, "argument must be bytes, not %.50s",
+                     Py_TYPE(arg)->tp_name);
+        return false;
+    }
+    value = PyBytes_AS_STRING(arg);
+    if (strlen(value) != static_cast<size_t>(PyBytes_GET_SIZE(arg))) {
+        PyErr_SetString(PyExc_ValueError, "embedded null byte");
+        return false;
+    }
+    return true;
+}
+
+// Pack the arguments passed on to a callback function
+static PyObject *args_to_tuple(PyObject *const *args, Py_ssize_t nargs) {
+    PyObject *tuple = PyTuple_New(nargs);
+    if (!tuple) {
+        return NULL;
+    }
+    for (Py_ssize_t i = 0; i < nargs; i++) {
+        Py_INCREF(args[i]);
+        PyTuple_SET_ITEM(tuple, i, args[i]);
+    }
+    return tuple;
+}
+
 struct sim_time {
     uint32_t high;
     uint32_t low;
@@ -170,8 +408,10 @@ int handle_gpi_callback(void *user_data) {
     DEFER(delete cb_data);
 
     // Call the callback
+    GPI_PROBE1(python_callback, cb_data);
     PyObject *pValue =
         PyObject_Call(cb_data->function, cb_data->args, cb_data->kwargs);
+    GPI_PROBE2(python_callback_return, cb_data, pValue != NULL);
 
     // If the return value is NULL a Python exception has occurred
     // The best thing to do here is shutdown as any subsequent
@@ -192,18 +432,102 @@ int handle_gpi_callback(void *user_data) {
     return 0;
 }
 
+// Calls the callback the group was armed with, see cb_group_arm()
+static int handle_gpi_group_callback(void *user_data) {
+    auto *obj = static_cast<gpi_hdl_Object<gpi_cb_group_hdl> *>(user_data);
+    // Firing disarms the group, so the callback is only used once
+    PythonCallback *cb_data = obj->cb_data;
+    obj->cb_data = nullptr;
+    // LCOV_EXCL_START
+    if (!cb_data) {
+        return 0;
+    }
+    // LCOV_EXCL_STOP
+    return handle_gpi_callback(cb_data);
+}
+
+// Handler of batched callbacks, see set_callback_batching()
+static PyObject *pBatchFn = NULL;
+
+/**
+ * @name    Batched Callback Handling
+ * @brief   Handle a batch of callbacks coming from GPI
+ * @ingroup python_c_api
+ *
+ * Calls the batch handler once with a list of ``(function, args)`` pairs of
+ * the callbacks, in the order they fired.
+ */
+static int handle_gpi_callback_batch(void *const *user_data, size_t count) {
+    to_python();
+    DEFER(to_simulator());
+
+    PyGILState_STATE gstate = PyGILState_Ensure();
+    DEFER(PyGILState_Release(gstate));
+
+    // The handler may be replaced while it runs
+    PyObject *handler = pBatchFn;
+    Py_XINCREF(handler);
+    DEFER(Py_XDECREF(handler));
+
+    PyObject *batch = handler ? PyList_New((Py_ssize_t)count) : NULL;
+    bool ok = batch != NULL;
+    for (size_t i = 0; i < count && ok; i++) {
+        PythonCallback *cb_data = (PythonCallback *)user_data[i];
+        PyObject *entry = PyTuple_Pack(2, cb_data->function, cb_data->args);
+        if (entry) {
+            PyList_SET_ITEM(batch, (Py_ssize_t)i, entry);
+        } else {
+            ok = false;
+        }
+    }
+
+    // Each callback is reported to tracers as if it was called on its own
+    for (size_t i = 0; i < count; i++) {
+        GPI_PROBE1(python_callback, user_data[i]);
+    }
+    PyObject *pValue =
+        ok ? PyObject_CallFunctionObjArgs(handler, batch, NULL) : NULL;
+    Py_XDECREF(batch);
+    for (size_t i = 0; i < count; i++) {
+        GPI_PROBE2(python_callback_return, user_data[i], pValue != NULL);
+        delete (PythonCallback *)user_data[i];
+    }
+
+    // If the return value is NULL a Python exception has occurred
+    if (pValue == NULL) {
+        // LCOV_EXCL_START
+        if (!handler) {
+            LOG_CRITICAL("Callbacks were batched without a batch handler");
+            return -1;
+        }
+        // LCOV_EXCL_STOP
+        // Printing a SystemExit calls exit(1), which we don't want.
+        if (!PyErr_ExceptionMatches(PyExc_SystemExit)) {
+            PyErr_Print();
+        }
+        // Clear error so re-entering Python doesn't fail.
+        PyErr_Clear();
+        return -1;
+    }
+
+    // We don't care about the result
+    Py_DECREF(pValue);
+
+    return 0;
+}
+
 // Register a callback for read-only state of sim
 // First argument is the function to call
 // Remaining arguments are keyword arguments to be passed to the callback
-static PyObject *register_readonly_callback(PyObject *, PyObject *args) {
+static PyObject *register_readonly_callback(PyObject *, FASTCALL_PARAMS) {
+    CHECK_NO_KWNAMES("register_readonly_callback");
+
     if (!gpi_has_registered_impl()) {
         PyErr_SetString(PyExc_RuntimeError, "No simulator available!");
         return NULL;
     }
 
-    Py_ssize_t numargs = PyTuple_Size(args);
-
-    if (numargs < 1) {
+    if (nargs < 1) {
         PyErr_SetString(PyExc_TypeError,
                         "Attempt to register ReadOnly callback without enough "
                         "arguments!\n");
@@ -211,7 +535,7 @@ static PyObject *register_readonly_callback(PyObject *, PyObject *args) {
     }
 
     // Extract the callback function
-    PyObject *function = PyTuple_GetItem(args, 0);  // borrow reference
+    PyObject *function = args[0];  // borrow reference
     if (!PyCallable_Check(function)) {
         PyErr_SetString(
             PyExc_TypeError,
@@ -220,7 +544,7 @@ static PyObject *register_readonly_callback(PyObject *, PyObject *args) {
     }
 
     // Remaining args for function
-    PyObject *fArgs = PyTuple_GetSlice(args, 1, numargs);  // New reference
+    PyObject *fArgs = args_to_tuple(args + 1, nargs - 1);  // New reference
     if (fArgs == NULL) {
         return NULL;
     }
@@ -236,15 +560,15 @@ static PyObject *register_readonly_callback(PyObject *, PyObject *args) {
     return rv;
 }
 
-static PyObject *register_rwsynch_callback(PyObject *, PyObject *args) {
+static PyObject *register_rwsynch_callback(PyObject *, FASTCALL_PARAMS) {
+    CHECK_NO_KWNAMES("register_rwsynch_callback");
+
     if (!gpi_has_registered_impl()) {
         PyErr_SetString(PyExc_RuntimeError, "No simulator available!");
         return NULL;
     }
 
-    Py_ssize_t numargs = PyTuple_Size(args);
-
-    if (numargs < 1) {
+    if (nargs < 1) {
         PyErr_SetString(PyExc_TypeError,
                         "Attempt to register ReadWrite callback without enough "
                         "arguments!\n");
@@ -252,7 +576,7 @@ static PyObject *register_rwsynch_callback(PyObject *, PyObject *args) {
     }
 
     // Extract the callback function
-    PyObject *function = PyTuple_GetItem(args, 0);  // borrow reference
+    PyObject *function = args[0];  // borrow reference
     if (!PyCallable_Check(function)) {
         PyErr_SetString(
             PyExc_TypeError,
@@ -261,7 +585,7 @@ static PyObject *register_rwsynch_callback(PyObject *, PyObject *args) {
     }
 
     // Remaining args for function
-    PyObject *fArgs = PyTuple_GetSlice(args, 1, numargs);  // New reference
+    PyObject *fArgs = args_to_tuple(args + 1, nargs - 1);  // New reference
     if (fArgs == NULL) {
         return NULL;
     }
@@ -277,15 +601,15 @@ static PyObject *register_rwsynch_callback(PyObject *, PyObject *args) {
     return rv;
 }
 
-static PyObject *register_nextstep_callback(PyObject *, PyObject *args) {
+static PyObject *register_nextstep_callback(PyObject *, FASTCALL_PARAMS) {
+    CHECK_NO_KWNAMES("register_nextstep_callback");
+
     if (!gpi_has_registered_impl()) {
         PyErr_SetString(PyExc_RuntimeError, "No simulator available!");
         return NULL;
     }
 
-    Py_ssize_t numargs = PyTuple_Size(args);
-
-    if (numargs < 1) {
+    if (nargs < 1) {
         PyErr_SetString(PyExc_TypeError,
                         "Attempt to register NextStep callback without enough "
                         "arguments!\n");
@@ -293,7 +617,7 @@ static PyObject *register_nextstep_callback(PyObject *, PyObject *args) {
     }
 
     // Extract the callback function
-    PyObject *function = PyTuple_GetItem(args, 0);  // borrow reference
+    PyObject *function = args[0];  // borrow reference
     if (!PyCallable_Check(function)) {
         PyErr_SetString(
             PyExc_TypeError,
@@ -302,7 +626,7 @@ static PyObject *register_nextstep_callback(PyObject *, PyObject *args) {
     }
 
     // Remaining args for function
-    PyObject *fArgs = PyTuple_GetSlice(args, 1, numargs);  // New reference
+    PyObject *fArgs = args_to_tuple(args + 1, nargs - 1);  // New reference
     if (fArgs == NULL) {
         return NULL;
     }
@@ -322,15 +646,15 @@ static PyObject *register_nextstep_callback(PyObject *, PyObject *args) {
 // First argument should be the time in picoseconds
 // Second argument is the function to call
 // Remaining arguments and keyword arguments are to be passed to the callback
-static PyObject *register_timed_callback(PyObject *, PyObject *args) {
+static PyObject *register_timed_callback(PyObject *, FASTCALL_PARAMS) {
+    CHECK_NO_KWNAMES("register_timed_callback");
+
     if (!gpi_has_registered_impl()) {
         PyErr_SetString(PyExc_RuntimeError, "No simulator available!");
         return NULL;
     }
 
-    Py_ssize_t numargs = PyTuple_Size(args);
-
-    if (numargs < 2) {
+    if (nargs < 2) {
         PyErr_SetString(
             PyExc_TypeError,
             "Attempt to register timed callback without enough arguments!\n");
@@ -339,7 +663,7 @@ static PyObject *register_timed_callback(PyObject *, PyObject *args) {
 
     uint64_t time;
     {  // Extract the time
-        PyObject *pTime = PyTuple_GetItem(args, 0);
+        PyObject *pTime = args[0];
         long long pTime_as_longlong = PyLong_AsLongLong(pTime);
         if (pTime_as_longlong == -1 && PyErr_Occurred()) {
             return NULL;
@@ -353,7 +677,7 @@ static PyObject *register_timed_callback(PyObject *, PyObject *args) {
     }
 
     // Extract the callback function
-    PyObject *function = PyTuple_GetItem(args, 1);  // borrow reference
+    PyObject *function = args[1];  // borrow reference
     if (!PyCallable_Check(function)) {
         PyErr_SetString(PyExc_TypeError,
                         "Attempt to register timed callback without passing a "
@@ -362,7 +686,7 @@ static PyObject *register_timed_callback(PyObject *, PyObject *args) {
     }
 
     // Remaining args for function
-    PyObject *fArgs = PyTuple_GetSlice(args, 2, numargs);  // New reference
+    PyObject *fArgs = args_to_tuple(args + 2, nargs - 2);  // New reference
     if (fArgs == NULL) {
         return NULL;
     }
@@ -383,24 +707,22 @@ static PyObject *register_timed_callback(PyObject *, PyObject *args) {
 // First argument should be the signal handle
 // Second argument is the function to call
 // Remaining arguments and keyword arguments are to be passed to the callback
-static PyObject *register_value_change_callback(
-    PyObject *, PyObject *args)  //, PyObject *keywds)
-{
+static PyObject *register_value_change_callback(PyObject *, FASTCALL_PARAMS) {
+    CHECK_NO_KWNAMES("register_value_change_callback");
+
     if (!gpi_has_registered_impl()) {
         PyErr_SetString(PyExc_RuntimeError, "No simulator available!");
         return NULL;
     }
 
-    Py_ssize_t numargs = PyTuple_Size(args);
-
-    if (numargs < 3) {
+    if (nargs < 3) {
         PyErr_SetString(PyExc_TypeError,
                         "Attempt to register value change callback without "
                         "enough arguments!\n");
         return NULL;
     }
 
-    PyObject *pSigHdl = PyTuple_GetItem(args, 0);
+    PyObject *pSigHdl = args[0];
     if (Py_TYPE(pSigHdl) != &gpi_hdl_Object<gpi_sim_hdl>::py_type) {
         PyErr_SetString(PyExc_TypeError,
                         "First argument must be a gpi_sim_hdl");
@@ -409,7 +731,7 @@ static PyObject *register_value_change_callback(
     gpi_sim_hdl sig_hdl = ((gpi_hdl_Object<gpi_sim_hdl> *)pSigHdl)->hdl;
 
     // Extract the callback function
-    PyObject *function = PyTuple_GetItem(args, 1);  // borrow reference
+    PyObject *function = args[1];  // borrow reference
     if (!PyCallable_Check(function)) {
         PyErr_SetString(PyExc_TypeError,
                         "Attempt to register value change callback without "
@@ -417,11 +739,11 @@ static PyObject *register_value_change_callback(
         return NULL;
     }
 
-    PyObject *pedge = PyTuple_GetItem(args, 2);  // borrow reference
+    PyObject *pedge = args[2];  // borrow reference
     gpi_edge edge = (gpi_edge)PyLong_AsLong(pedge);
 
     // Remaining args for function
-    PyObject *fArgs = PyTuple_GetSlice(args, 3, numargs);  // New reference
+    PyObject *fArgs = args_to_tuple(args + 3, nargs - 3);  // New reference
     if (fArgs == NULL) {
         return NULL;
     }
@@ -438,16 +760,88 @@ static PyObject *register_value_change_callback(
     return rv;
 }
 
-static PyObject *iterate(gpi_hdl_Object<gpi_sim_hdl> *self, PyObject *args) {
+// Register signal change callback on some bits of the signal
+// Third argument is the mask of bits to watch
+// Fourth argument is the target value of those bits or None
+static PyObject *register_masked_value_change_callback(PyObject *,
+                                                       FASTCALL_PARAMS) {
+    CHECK_NO_KWNAMES("register_masked_value_change_callback");
+
+    if (!gpi_has_registered_impl()) {
+        PyErr_SetString(PyExc_RuntimeError, "No simulator available!");
+        return NULL;
+    }
+
+    if (nargs < 4) {
+        PyErr_SetString(PyExc_TypeError,
+                        "Attempt to register value change callback without "
+                        "enough arguments!\n");
+        return NULL;
+    }
+
+    PyObject *pSigHdl = args[0];
+    if (Py_TYPE(pSigHdl) != &gpi_hdl_Object<gpi_sim_hdl>::py_type) {
+        PyErr_SetString(PyExc_TypeError,
+                        "First argument must be a gpi_sim_hdl");
+        return NULL;
+    }
+    gpi_sim_hdl sig_hdl = ((gpi_hdl_Object<gpi_sim_hdl> *)pSigHdl)->hdl;
+
+    // Extract the callback function
+    PyObject *function = args[1];  // borrow reference
+    if (!PyCallable_Check(function)) {
+        PyErr_SetString(PyExc_TypeError,
+                        "Attempt to register value change callback without "
+                        "passing a callable callback!\n");
+        return NULL;
+    }
+
+    const char *mask;
+    if (!parse_str(args[2], mask)) {
+        return NULL;
+    }
+    const char *value = NULL;
+    if (args[3] != Py_None && !parse_str(args[3], value)) {
+        return NULL;
+    }
+
+    // Remaining args for function
+    PyObject *fArgs = args_to_tuple(args + 4, nargs - 4);  // New reference
+    if (fArgs == NULL) {
+        return NULL;
+    }
+    DEFER(Py_DECREF(fArgs));
+
+    PythonCallback *cb_data = new PythonCallback(function, fArgs, NULL);
+
+    gpi_cb_hdl hdl = gpi_register_masked_value_change_callback(
+        (gpi_function_t)handle_gpi_callback, cb_data, sig_hdl, mask, value);
+    if (!hdl) {
+        delete cb_data;
+    }
+
+    // Check success
+    PyObject *rv = gpi_hdl_New(hdl);
+
+    return rv;
+}
+
+static PyObject *iterate(gpi_hdl_Object<gpi_sim_hdl> *self, PyObject *arg) {
     int type;
 
-    if (!PyArg_ParseTuple(args, "i:iterate", &type)) {
+    if (!parse_int(arg, type)) {
         return NULL;
     }
 
     gpi_iterator_hdl result = gpi_iterate(self->hdl, (gpi_iterator_sel)type);
 
-    return gpi_hdl_New(result);
+    PyObject *iter = gpi_hdl_New(result);
+    if (iter && iter != Py_None) {
+        Py_INCREF(self);
+        reinterpret_cast<gpi_hdl_Object<gpi_iterator_hdl> *>(iter)->parent =
+            (PyObject *)self;
+    }
+    return iter;
 }
 
 static PyObject *package_iterate(PyObject *, PyObject *) {
@@ -510,54 +904,213 @@ static PyObject *get_signal_val_long(gpi_hdl_Object<gpi_sim_hdl> *self,
 }
 
 static PyObject *set_signal_val_binstr(gpi_hdl_Object<gpi_sim_hdl> *self,
-                                       PyObject *args) {
+                                       FASTCALL_PARAMS) {
+    CHECK_NO_KWNAMES("set_signal_val_binstr");
+    const char *binstr;
+    int action;
+
+    if (!check_nargs("set_signal_val_binstr", nargs, 2, 2) ||
+        !parse_int(args[0], action) || !parse_str(args[1], binstr)) {
+        return NULL;
+    }
+
+    gpi_set_signal_value_binstr(self->hdl, binstr, (gpi_set_action)action);
+    Py_RETURN_NONE;
+}
+
+static PyObject *get_signal_slice(gpi_hdl_Object<gpi_sim_hdl> *self,
+                                  FASTCALL_PARAMS) {
+    CHECK_NO_KWNAMES("get_signal_slice");
+    int left;
+    int right;
+
+    if (!check_nargs("get_signal_slice", nargs, 2, 2) ||
+        !parse_int(args[0], left) || !parse_int(args[1], right)) {
+        return NULL;
+    }
+
+    const char *result = gpi_get_signal_slice(self->hdl, left, right);
+    if (result == NULL) {
+        PyErr_Format(PyExc_IndexError, "Unable to get slice %d to %d", left,
+                     right);
+        return NULL;
+    }
+    return PyUnicode_FromString(result);
+}
+
+static PyObject *set_signal_slice(gpi_hdl_Object<gpi_sim_hdl> *self,
+                                  FASTCALL_PARAMS) {
+    CHECK_NO_KWNAMES("set_signal_slice");
+    int action;
+    int left;
+    int right;
     const char *binstr;
-    gpi_set_action action;
 
-    if (!PyArg_ParseTuple(args, "is:set_signal_val_binstr", &action, &binstr)) {
+    if (!check_nargs("set_signal_slice", nargs, 4, 4) ||
+        !parse_int(args[0], action) || !parse_int(args[1], left) ||
+        !parse_int(args[2], right) || !parse_str(args[3], binstr)) {
         return NULL;
     }
 
-    gpi_set_signal_value_binstr(self->hdl, binstr, action);
+    if (gpi_set_signal_slice(self->hdl, left, right, binstr,
+                             (gpi_set_action)action)) {
+        PyErr_Format(PyExc_RuntimeError, "Unable to set slice %d to %d", left,
+                     right);
+        return NULL;
+    }
     Py_RETURN_NONE;
 }
 
 static PyObject *set_signal_val_str(gpi_hdl_Object<gpi_sim_hdl> *self,
-                                    PyObject *args) {
-    gpi_set_action action;
+                                    FASTCALL_PARAMS) {
+    CHECK_NO_KWNAMES("set_signal_val_str");
+    int action;
     const char *str;
 
-    if (!PyArg_ParseTuple(args, "iy:set_signal_val_str", &action, &str)) {
+    if (!check_nargs("set_signal_val_str", nargs, 2, 2) ||
+        !parse_int(args[0], action) || !parse_bytes(args[1], str)) {
         return NULL;
     }
 
-    gpi_set_signal_value_str(self->hdl, str, action);
+    gpi_set_signal_value_str(self->hdl, str, (gpi_set_action)action);
     Py_RETURN_NONE;
 }
 
 static PyObject *set_signal_val_real(gpi_hdl_Object<gpi_sim_hdl> *self,
-                                     PyObject *args) {
+                                     FASTCALL_PARAMS) {
+    CHECK_NO_KWNAMES("set_signal_val_real");
     double value;
-    gpi_set_action action;
+    int action;
 
-    if (!PyArg_ParseTuple(args, "id:set_signal_val_real", &action, &value)) {
+    if (!check_nargs("set_signal_val_real", nargs, 2, 2) ||
+        !parse_int(args[0], action) || !parse_double(args[1], value)) {
         return NULL;
     }
 
-    gpi_set_signal_value_real(self->hdl, value, action);
+    gpi_set_signal_value_real(self->hdl, value, (gpi_set_action)action);
     Py_RETURN_NONE;
 }
 
 static PyObject *set_signal_val_int(gpi_hdl_Object<gpi_sim_hdl> *self,
-                                    PyObject *args) {
+                                    FASTCALL_PARAMS) {
+    CHECK_NO_KWNAMES("set_signal_val_int");
     long long value;
-    gpi_set_action action;
+    int action;
+
+    if (!check_nargs("set_signal_val_int", nargs, 2, 2) ||
+        !parse_int(args[0], action) || !parse_long_long(args[1], value)) {
+        return NULL;
+    }
+
+    gpi_set_signal_value_int(self->hdl, static_cast<int32_t>(value),
+                             (gpi_set_action)action);
+    Py_RETURN_NONE;
+}
+
+static PyObject *get_array_element_width(gpi_hdl_Object<gpi_sim_hdl> *self,
+                                         PyObject *) {
+    return PyLong_FromLong(gpi_get_array_element_width(self->hdl));
+}
+
+/* Get a buffer with room for *count* elements of the array for
+ * read_array()/write_array()
+ */
+static bool get_array_buffer(gpi_sim_hdl hdl, PyObject *obj, int count,
+                             int format, int flags, Py_buffer *view) {
+    if (format != GPI_ARRAY_BINSTR && format != GPI_ARRAY_UINT &&
+        format != GPI_ARRAY_REAL) {
+        PyErr_Format(PyExc_ValueError, "Invalid array format %d", format);
+        return false;
+    }
+    if (count < 0) {
+        PyErr_SetString(PyExc_ValueError, "count must not be negative");
+        return false;
+    }
+    int width = gpi_get_array_element_width(hdl);
+    if (width < 0) {
+        PyErr_SetString(PyExc_TypeError,
+                        "Elements of the array are not signals");
+        return false;
+    }
+    if (PyObject_GetBuffer(obj, view, flags) < 0) {
+        return false;
+    }
+    size_t elem_size;
+    switch (format) {
+        case GPI_ARRAY_UINT:
+            elem_size = static_cast<size_t>((width + 7) / 8);
+            break;
+        case GPI_ARRAY_REAL:
+            elem_size = sizeof(double);
+            break;
+        default:
+            elem_size = static_cast<size_t>(width);
+    }
+    size_t needed = static_cast<size_t>(count) * elem_size;
+    if (static_cast<size_t>(view->len) < needed) {
+        PyErr_Format(PyExc_ValueError,
+                     "Buffer of %zd bytes is too small for %d elements of %d "
+                     "bits",
+                     view->len, count, width);
+        PyBuffer_Release(view);
+        return false;
+    }
+    return true;
+}
 
-    if (!PyArg_ParseTuple(args, "iL:set_signal_val_int", &action, &value)) {
+static PyObject *read_array(gpi_hdl_Object<gpi_sim_hdl> *self,
+                            FASTCALL_PARAMS) {
+    CHECK_NO_KWNAMES("read_array");
+    int first;
+    int count;
+    int format;
+    Py_buffer view;
+
+    if (!check_nargs("read_array", nargs, 4, 4) ||
+        !parse_int(args[0], first) || !parse_int(args[1], count) ||
+        !parse_int(args[2], format) ||
+        !get_array_buffer(self->hdl, args[3], count, format, PyBUF_WRITABLE,
+                          &view)) {
         return NULL;
     }
 
-    gpi_set_signal_value_int(self->hdl, static_cast<int32_t>(value), action);
+    int ret = gpi_read_array(self->hdl, first, count,
+                             static_cast<gpi_array_format>(format), view.buf);
+    PyBuffer_Release(&view);
+    if (ret) {
+        PyErr_Format(PyExc_RuntimeError,
+                     "Unable to read %d elements at index %d", count, first);
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *write_array(gpi_hdl_Object<gpi_sim_hdl> *self,
+                             FASTCALL_PARAMS) {
+    CHECK_NO_KWNAMES("write_array");
+    int action;
+    int first;
+    int count;
+    int format;
+    Py_buffer view;
+
+    if (!check_nargs("write_array", nargs, 5, 5) ||
+        !parse_int(args[0], action) || !parse_int(args[1], first) ||
+        !parse_int(args[2], count) || !parse_int(args[3], format) ||
+        !get_array_buffer(self->hdl, args[4], count, format, PyBUF_SIMPLE,
+                          &view)) {
+        return NULL;
+    }
+
+    int ret = gpi_write_array(self->hdl, first, count,
+                              static_cast<gpi_array_format>(format), view.buf,
+                              (gpi_set_action)action);
+    PyBuffer_Release(&view);
+    if (ret) {
+        PyErr_Format(PyExc_RuntimeError,
+                     "Unable to write %d elements at index %d", count, first);
+        return NULL;
+    }
     Py_RETURN_NONE;
 }
 
@@ -574,14 +1127,16 @@ static PyObject *get_definition_file(gpi_hdl_Object<gpi_sim_hdl> *self,
 }
 
 static PyObject *get_handle_by_name(gpi_hdl_Object<gpi_sim_hdl> *self,
-                                    PyObject *args) {
+                                    FASTCALL_PARAMS) {
+    CHECK_NO_KWNAMES("get_handle_by_name");
     const char *name;
     // if unset, we assume AUTO, which maintains backward-compatibility
     int py_discovery_method = 0;
     gpi_discovery c_discovery_method = GPI_AUTO;
 
-    if (!PyArg_ParseTuple(args, "s|i:get_handle_by_name", &name,
-                          &py_discovery_method)) {
+    if (!check_nargs("get_handle_by_name", nargs, 1, 2) ||
+        !parse_str(args[0], name) ||
+        (nargs > 1 && !parse_int(args[1], py_discovery_method))) {
         return NULL;
     }
     // do some additional input validation, then map to enum
@@ -600,10 +1155,10 @@ static PyObject *get_handle_by_name(gpi_hdl_Object<gpi_sim_hdl> *self,
 }
 
 static PyObject *get_handle_by_index(gpi_hdl_Object<gpi_sim_hdl> *self,
-                                     PyObject *args) {
-    int32_t index;
+                                     PyObject *arg) {
+    int index;
 
-    if (!PyArg_ParseTuple(args, "i:get_handle_by_index", &index)) {
+    if (!parse_int(arg, index)) {
         return NULL;
     }
 
@@ -612,15 +1167,16 @@ static PyObject *get_handle_by_index(gpi_hdl_Object<gpi_sim_hdl> *self,
     return gpi_hdl_New(result);
 }
 
-static PyObject *get_root_handle(PyObject *, PyObject *args) {
-    const char *name;
+static PyObject *get_root_handle(PyObject *, PyObject *arg) {
+    const char *name = NULL;
 
     if (!gpi_has_registered_impl()) {
         PyErr_SetString(PyExc_RuntimeError, "No simulator available!");
         return NULL;
     }
 
-    if (!PyArg_ParseTuple(args, "z:get_root_handle", &name)) {
+    // "z"
+    if (arg != Py_None && !parse_str(arg, name)) {
         return NULL;
     }
 
@@ -634,8 +1190,15 @@ static PyObject *get_root_handle(PyObject *, PyObject *args) {
 
 static PyObject *get_name_string(gpi_hdl_Object<gpi_sim_hdl> *self,
                                  PyObject *) {
-    const char *result = gpi_get_signal_name_str(self->hdl);
-    return PyUnicode_FromString(result);
+    if (!self->name) {
+        self->name =
+            PyUnicode_InternFromString(gpi_get_signal_name_str(self->hdl));
+        if (!self->name) {
+            return NULL;
+        }
+    }
+    Py_INCREF(self->name);
+    return self->name;
 }
 
 static PyObject *get_type(gpi_hdl_Object<gpi_sim_hdl> *self, PyObject *) {
@@ -654,6 +1217,67 @@ static PyObject *get_type_string(gpi_hdl_Object<gpi_sim_hdl> *self,
     return PyUnicode_FromString(result);
 }
 
+static PyStructSequence_Field object_info_fields[] = {
+    {"type", "GPI type of the object as an enum."},
+    {"type_string", "GPI type of the object as a string."},
+    {"name", "Name of the object."},
+    {"const", "``True`` if the object is a constant."},
+    {"indexable", "``True`` if the object is indexable."},
+    {"num_elems", "Number of elements contained in the handle."},
+    {"range", "Left bound, right bound and direction of the range."},
+    {"definition_name", "Name of the object's definition."},
+    {"definition_file", "File that sources the object's definition."},
+    {NULL, NULL}};
+
+static PyStructSequence_Desc object_info_desc = {
+    "cocotb.simulator.gpi_object_info",
+    "Properties of a GPI object, returned by :meth:`gpi_sim_hdl.get_info`.",
+    object_info_fields, 9};
+
+static PyTypeObject object_info_type;
+
+static PyObject *get_info(gpi_hdl_Object<gpi_sim_hdl> *self, PyObject *) {
+    gpi_object_info info;
+    gpi_get_object_info(self->hdl, &info);
+
+    if (!self->name) {
+        self->name = PyUnicode_InternFromString(info.name);
+        if (!self->name) {
+            return NULL;
+        }
+    }
+
+    PyObject *result = PyStructSequence_New(&object_info_type);
+    if (!result) {
+        return NULL;
+    }
+    Py_INCREF(self->name);
+    PyStructSequence_SET_ITEM(result, 0, PyLong_FromLong(info.type));
+    PyStructSequence_SET_ITEM(result, 1, PyUnicode_FromString(info.type_str));
+    PyStructSequence_SET_ITEM(result, 2, self->name);
+    PyStructSequence_SET_ITEM(result, 3, PyBool_FromLong(info.is_const));
+    PyStructSequence_SET_ITEM(result, 4, PyBool_FromLong(info.is_indexable));
+    PyStructSequence_SET_ITEM(result, 5, PyLong_FromLong(info.num_elems));
+    PyStructSequence_SET_ITEM(
+        result, 6,
+        Py_BuildValue("(i,i,i)", info.range_left, info.range_right,
+                      info.range_dir));
+    PyStructSequence_SET_ITEM(result, 7,
+                              PyUnicode_FromString(info.definition_name));
+    PyStructSequence_SET_ITEM(result, 8,
+                              PyUnicode_FromString(info.definition_file));
+
+    for (Py_ssize_t i = 0; i < 9; i++) {
+        // LCOV_EXCL_START
+        if (!PyStructSequence_GET_ITEM(result, i)) {
+            Py_DECREF(result);
+            return NULL;
+        }
+        // LCOV_EXCL_STOP
+    }
+    return result;
+}
+
 static PyObject *is_running(PyObject *, PyObject *) {
     return PyBool_FromLong(gpi_has_registered_impl());
 }
@@ -762,10 +1386,10 @@ static PyObject *deregister(gpi_hdl_Object<gpi_cb_hdl> *self, PyObject *) {
     Py_RETURN_NONE;
 }
 
-static PyObject *set_gpi_log_level(PyObject *, PyObject *args) {
+static PyObject *set_gpi_log_level(PyObject *, PyObject *arg) {
     int l_level;
 
-    if (!PyArg_ParseTuple(args, "i:log_level", &l_level)) {
+    if (!parse_int(arg, l_level)) {
         return NULL;
     }
 
@@ -774,34 +1398,419 @@ static PyObject *set_gpi_log_level(PyObject *, PyObject *args) {
     Py_RETURN_NONE;
 }
 
-static PyObject *initialize_logger(PyObject *, PyObject *args) {
-    PyObject *log_func;
-    PyObject *get_logger;
-    if (!PyArg_ParseTuple(args, "OO", &log_func, &get_logger)) {
-        PyErr_Print();
+static PyObject *initialize_logger(PyObject *, FASTCALL_PARAMS) {
+    CHECK_NO_KWNAMES("initialize_logger");
+    if (!check_nargs("initialize_logger", nargs, 2, 2)) {
         return NULL;
     }
-    py_gpi_logger_initialize(log_func, get_logger);
+    py_gpi_logger_initialize(args[0], args[1]);
+    Py_RETURN_NONE;
+}
+
+static PyObject *clear_logger_level_cache(PyObject *, PyObject *) {
+    py_gpi_logger_clear_level_cache();
     Py_RETURN_NONE;
 }
 
-static PyObject *set_sim_event_callback(PyObject *, PyObject *args) {
+static PyObject *set_sim_event_callback(PyObject *,
+                                        PyObject *sim_event_callback) {
     if (pEventFn) {
         PyErr_SetString(PyExc_RuntimeError,
                         "Simulator event callback already set!");
         return NULL;
     }
 
-    PyObject *sim_event_callback;
-    if (!PyArg_ParseTuple(args, "O", &sim_event_callback)) {
-        PyErr_Print();
-        Py_RETURN_NONE;
-    }
     Py_INCREF(sim_event_callback);
     pEventFn = sim_event_callback;
     Py_RETURN_NONE;
 }
 
+static PyObject *stats_by_name(const uint64_t *values,
+                               const char *const *names, size_t count) {
+    PyObject *dict = PyDict_New();
+    if (!dict) {
+        return NULL;
+    }
+    for (size_t i = 0; i < count; i++) {
+        PyObject *value = PyLong_FromUnsignedLongLong(values[i]);
+        if (!value || PyDict_SetItemString(dict, names[i], value) < 0) {
+            Py_XDECREF(value);
+            Py_DECREF(dict);
+            return NULL;
+        }
+        Py_DECREF(value);
+    }
+    return dict;
+}
+
+static PyObject *get_stats(PyObject *, PyObject *) {
+    static const char *const cb_type_names[GPI_CB_NUM_TYPES] = {
+        "timed", "value_change", "readonly", "nexttime", "readwrite", "other"};
+    static const char *const format_names[GPI_NUM_FORMATS] = {"binstr", "str",
+                                                              "real", "int"};
+
+    gpi_stats stats;
+    gpi_get_stats(&stats);
+
+    PyObject *callbacks = PyDict_New();
+    if (!callbacks) {
+        return NULL;
+    }
+    DEFER(Py_DECREF(callbacks));
+
+    for (size_t i = 0; i < GPI_CB_NUM_TYPES; i++) {
+        PyObject *hist = PyList_New(GPI_STATS_HIST_BUCKETS);
+        if (!hist) {
+            return NULL;
+        }
+        for (Py_ssize_t j = 0; j < GPI_STATS_HIST_BUCKETS; j++) {
+            PyObject *bucket =
+                PyLong_FromUnsignedLongLong(stats.cb_hist[i][j]);
+            if (!bucket) {
+                Py_DECREF(hist);
+                return NULL;
+            }
+            PyList_SET_ITEM(hist, j, bucket);
+        }
+        PyObject *entry = Py_BuildValue("{s:K,s:K,s:N}", "count",
+                                        stats.cb_count[i], "time_ns",
+                                        stats.cb_time_ns[i], "histogram", hist);
+        if (!entry) {
+            return NULL;
+        }
+        int err = PyDict_SetItemString(callbacks, cb_type_names[i], entry);
+        Py_DECREF(entry);
+        if (err < 0) {
+            return NULL;
+        }
+    }
+
+    PyObject *reads = stats_by_name(stats.reads, format_names, GPI_NUM_FORMATS);
+    if (!reads) {
+        return NULL;
+    }
+    PyObject *writes =
+        stats_by_name(stats.writes, format_names, GPI_NUM_FORMATS);
+    if (!writes) {
+        Py_DECREF(reads);
+        return NULL;
+    }
+    PyObject *simulator = stats_by_name(
+        stats.sim_counters, stats.sim_counter_names, stats.num_sim_counters);
+    if (!simulator) {
+        Py_DECREF(reads);
+        Py_DECREF(writes);
+        return NULL;
+    }
+
+    return Py_BuildValue(
+        "{s:O,s:K,s:K,s:N,s:N,s:K,s:K,s:K,s:K,s:K,s:N}", "callbacks",
+        callbacks, "gpi_time_ns", stats.gpi_time_ns, "sim_time_ns",
+        stats.sim_time_ns, "reads", reads, "writes", writes, "slow_callbacks",
+        stats.slow_cb_count, "slow_callback_threshold_ns",
+        stats.slow_cb_threshold_ns, "value_cache_hits",
+        stats.value_cache_hits, "elided_writes", stats.elided_writes,
+        "batched_callbacks", stats.batched_cb_count, "simulator", simulator);
+}
+
+static PyObject *get_memory_stats(PyObject *, PyObject *) {
+    gpi_memory_stats stats;
+    gpi_get_memory_stats(&stats);
+
+    return Py_BuildValue("{s:n,s:n,s:n,s:n}", "handles",
+                         (Py_ssize_t)stats.num_handles, "handle_bytes",
+                         (Py_ssize_t)stats.handle_bytes, "strings",
+                         (Py_ssize_t)stats.num_strings, "string_bytes",
+                         (Py_ssize_t)stats.string_bytes);
+}
+
+static PyObject *reset_stats(PyObject *, PyObject *) {
+    gpi_reset_stats();
+    Py_RETURN_NONE;
+}
+
+static PyObject *set_slow_callback_threshold(PyObject *, PyObject *arg) {
+    unsigned long long threshold_ns;
+
+    if (!parse_unsigned_long_long_mask(arg, threshold_ns)) {
+        return NULL;
+    }
+
+    gpi_set_slow_callback_threshold(threshold_ns);
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *set_readonly_value_cache(PyObject *, PyObject *arg) {
+    // "p"
+    int enable = PyObject_IsTrue(arg);
+    if (enable < 0) {
+        return NULL;
+    }
+
+    gpi_set_readonly_value_cache(enable);
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *set_write_elision(PyObject *, PyObject *arg) {
+    // "p"
+    int enable = PyObject_IsTrue(arg);
+    if (enable < 0) {
+        return NULL;
+    }
+
+    gpi_set_write_elision(enable);
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *set_callback_batching(PyObject *, PyObject *handler) {
+    if (handler != Py_None && !PyCallable_Check(handler)) {
+        PyErr_Format(PyExc_TypeError,
+                     "argument must be callable or None, not %.50s",
+                     Py_TYPE(handler)->tp_name);
+        return NULL;
+    }
+
+    PyObject *old_handler = pBatchFn;
+    if (handler == Py_None) {
+        pBatchFn = NULL;
+        gpi_set_callback_batching(NULL, NULL);
+    } else {
+        Py_INCREF(handler);
+        pBatchFn = handler;
+        gpi_set_callback_batching((gpi_function_t)handle_gpi_callback,
+                                  handle_gpi_callback_batch);
+    }
+    Py_XDECREF(old_handler);
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *fork_simulator(PyObject *, PyObject *) {
+#if PY_VERSION_HEX >= 0x03070000
+    PyOS_BeforeFork();
+#endif
+    long pid = gpi_fork();
+#if PY_VERSION_HEX >= 0x03070000
+    if (pid == 0) {
+        PyOS_AfterFork_Child();
+    } else {
+        PyOS_AfterFork_Parent();
+    }
+#else
+    if (pid == 0) {
+        PyOS_AfterFork();
+    }
+#endif
+
+    if (pid < 0) {
+        PyErr_SetString(PyExc_RuntimeError, "Unable to fork the simulator");
+        return NULL;
+    }
+    return PyLong_FromLong(pid);
+}
+
+static PyObject *checkpoint_save(PyObject *, PyObject *arg) {
+    const char *filename;
+
+    if (!parse_str(arg, filename)) {
+        return NULL;
+    }
+
+    if (gpi_checkpoint_save(filename)) {
+        PyErr_Format(PyExc_RuntimeError, "Unable to save a checkpoint to %s",
+                     filename);
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+// Collect the handles of a sequence of real signals, and a buffer with room
+// for a double for each of them
+static bool get_real_signals(const char *name, PyObject *seq, PyObject *obj,
+                             int flags, std::vector<gpi_sim_hdl> &hdls,
+                             Py_buffer *view) {
+    PyObject *fast = PySequence_Fast(seq, "handles must be a sequence");
+    if (!fast) {
+        return false;
+    }
+    Py_ssize_t count = PySequence_Fast_GET_SIZE(fast);
+    PyObject **items = PySequence_Fast_ITEMS(fast);
+    hdls.resize(static_cast<size_t>(count));
+    for (Py_ssize_t i = 0; i < count; i++) {
+        if (Py_TYPE(items[i]) != &gpi_hdl_Object<gpi_sim_hdl>::py_type) {
+            PyErr_Format(PyExc_TypeError,
+                         "%s() handles must be cocotb.simulator.gpi_sim_hdl, "
+                         "not %.50s",
+                         name, Py_TYPE(items[i])->tp_name);
+            Py_DECREF(fast);
+            return false;
+        }
+        hdls[static_cast<size_t>(i)] =
+            ((gpi_hdl_Object<gpi_sim_hdl> *)items[i])->hdl;
+    }
+    Py_DECREF(fast);
+    if (count > INT_MAX) {
+        PyErr_SetString(PyExc_OverflowError, "Too many handles");
+        return false;
+    }
+
+    if (PyObject_GetBuffer(obj, view, flags) < 0) {
+        return false;
+    }
+    if (static_cast<size_t>(view->len) <
+        static_cast<size_t>(count) * sizeof(double)) {
+        PyErr_Format(PyExc_ValueError,
+                     "Buffer of %zd bytes is too small for %zd reals",
+                     view->len, count);
+        PyBuffer_Release(view);
+        return false;
+    }
+    return true;
+}
+
+static PyObject *get_signal_vals_real(PyObject *, FASTCALL_PARAMS) {
+    CHECK_NO_KWNAMES("get_signal_vals_real");
+    std::vector<gpi_sim_hdl> hdls;
+    Py_buffer view;
+
+    if (!check_nargs("get_signal_vals_real", nargs, 2, 2) ||
+        !get_real_signals("get_signal_vals_real", args[0], args[1],
+                          PyBUF_WRITABLE, hdls, &view)) {
+        return NULL;
+    }
+
+    int ret = gpi_get_signal_values_real(
+        hdls.data(), static_cast<int>(hdls.size()),
+        static_cast<double *>(view.buf));
+    PyBuffer_Release(&view);
+    if (ret) {
+        PyErr_SetString(PyExc_TypeError, "Handles must be real signals");
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *set_signal_vals_real(PyObject *, FASTCALL_PARAMS) {
+    CHECK_NO_KWNAMES("set_signal_vals_real");
+    int action;
+    std::vector<gpi_sim_hdl> hdls;
+    Py_buffer view;
+
+    if (!check_nargs("set_signal_vals_real", nargs, 3, 3) ||
+        !parse_int(args[0], action) ||
+        !get_real_signals("set_signal_vals_real", args[1], args[2],
+                          PyBUF_SIMPLE, hdls, &view)) {
+        return NULL;
+    }
+
+    int ret = gpi_set_signal_values_real(
+        hdls.data(), static_cast<int>(hdls.size()),
+        static_cast<const double *>(view.buf), (gpi_set_action)action);
+    PyBuffer_Release(&view);
+    if (ret) {
+        PyErr_SetString(PyExc_TypeError, "Handles must be real signals");
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+// Parse the (handle, path, format, offset=0) arguments of load_memory() and
+// dump_memory()
+static bool parse_memory_args(const char *name, PyObject *const *args,
+                              Py_ssize_t nargs, gpi_sim_hdl &hdl,
+                              const char *&path, gpi_mem_format &format,
+                              long long &offset) {
+    if (!check_nargs(name, nargs, 3, 4)) {
+        return false;
+    }
+    if (Py_TYPE(args[0]) != &gpi_hdl_Object<gpi_sim_hdl>::py_type) {
+        PyErr_Format(PyExc_TypeError,
+                     "%s() argument 1 must be cocotb.simulator.gpi_sim_hdl, "
+                     "not %.50s",
+                     name, Py_TYPE(args[0])->tp_name);
+        return false;
+    }
+    hdl = ((gpi_hdl_Object<gpi_sim_hdl> *)args[0])->hdl;
+
+    int format_int;
+    if (!parse_str(args[1], path) || !parse_int(args[2], format_int)) {
+        return false;
+    }
+    if (format_int != GPI_MEM_BIN && format_int != GPI_MEM_HEX &&
+        format_int != GPI_MEM_ELF) {
+        PyErr_Format(PyExc_ValueError, "Invalid memory image format %d",
+                     format_int);
+        return false;
+    }
+    format = static_cast<gpi_mem_format>(format_int);
+
+    offset = 0;
+    return nargs < 4 || parse_long_long(args[3], offset);
+}
+
+static PyObject *load_memory(PyObject *, FASTCALL_PARAMS) {
+    CHECK_NO_KWNAMES("load_memory");
+
+    gpi_sim_hdl hdl;
+    const char *path;
+    gpi_mem_format format;
+    long long offset;
+    if (!parse_memory_args("load_memory", args, nargs, hdl, path, format,
+                           offset)) {
+        return NULL;
+    }
+
+    if (gpi_load_memory(hdl, path, format, offset)) {
+        PyErr_Format(PyExc_RuntimeError, "Unable to load %s into %s", path,
+                     gpi_get_signal_name_str(hdl));
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *dump_memory(PyObject *, FASTCALL_PARAMS) {
+    CHECK_NO_KWNAMES("dump_memory");
+
+    gpi_sim_hdl hdl;
+    const char *path;
+    gpi_mem_format format;
+    long long offset;
+    if (!parse_memory_args("dump_memory", args, nargs, hdl, path, format,
+                           offset)) {
+        return NULL;
+    }
+
+    if (gpi_dump_memory(hdl, path, format, offset)) {
+        PyErr_Format(PyExc_RuntimeError, "Unable to dump %s to %s",
+                     gpi_get_signal_name_str(hdl), path);
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *set_waveform_dumping(PyObject *, PyObject *arg) {
+    // "p"
+    int enable = PyObject_IsTrue(arg);
+    if (enable < 0) {
+        return NULL;
+    }
+
+    if (gpi_set_waveform_dumping(enable)) {
+        PyErr_SetString(PyExc_RuntimeError,
+                        enable ? "Unable to start dumping waveforms"
+                               : "Unable to stop dumping waveforms");
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
 class GpiClock {
   public:
     GpiClock(GpiObjHdl *clk_sig) : clk_signal(clk_sig) {}
@@ -889,7 +1898,7 @@ int GpiClock::toggle_cb(void *gpi_clk) {
 }
 
 // Create a new clock object
-static PyObject *clock_create(PyObject *, PyObject *args) {
+static PyObject *clock_create(PyObject *, PyObject *pSigHdl) {
     if (!gpi_has_registered_impl()) {
         // LCOV_EXCL_START
         PyErr_SetString(PyExc_RuntimeError, "No simulator available!");
@@ -898,9 +1907,11 @@ static PyObject *clock_create(PyObject *, PyObject *args) {
     }
 
     // Extract the clock signal sim object
-    PyObject *pSigHdl;
-    if (!PyArg_ParseTuple(args, "O!:clock_create",
-                          &gpi_hdl_Object<gpi_sim_hdl>::py_type, &pSigHdl)) {
+    if (Py_TYPE(pSigHdl) != &gpi_hdl_Object<gpi_sim_hdl>::py_type) {
+        PyErr_Format(PyExc_TypeError,
+                     "clock_create() argument must be "
+                     "cocotb.simulator.gpi_sim_hdl, not %.50s",
+                     Py_TYPE(pSigHdl)->tp_name);
         return NULL;
     }
     gpi_sim_hdl sim_hdl = ((gpi_hdl_Object<gpi_sim_hdl> *)pSigHdl)->hdl;
@@ -939,13 +1950,18 @@ static void clock_dealloc(PyObject *self) {
     Py_TYPE(self)->tp_free((PyObject *)self);
 }
 
-static PyObject *clk_start(gpi_hdl_Object<gpi_clk_hdl> *self, PyObject *args) {
+static PyObject *clk_start(gpi_hdl_Object<gpi_clk_hdl> *self,
+                           FASTCALL_PARAMS) {
+    CHECK_NO_KWNAMES("start");
     unsigned long long period, t_high;
     int start_high;
     int set_action;
 
-    if (!PyArg_ParseTuple(args, "KKpi:start", &period, &t_high, &start_high,
-                          &set_action)) {
+    if (!check_nargs("start", nargs, 4, 4) ||
+        !parse_unsigned_long_long_mask(args[0], period) ||
+        !parse_unsigned_long_long_mask(args[1], t_high) ||
+        (start_high = PyObject_IsTrue(args[2])) < 0 ||
+        !parse_int(args[3], set_action)) {
         return NULL;
     }
 
@@ -976,6 +1992,125 @@ static PyObject *clk_stop(gpi_hdl_Object<gpi_clk_hdl> *self, PyObject *) {
     Py_RETURN_NONE;
 }
 
+// Create an empty group of value change callbacks
+static PyObject *create_value_change_group(PyObject *, PyObject *) {
+    if (!gpi_has_registered_impl()) {
+        PyErr_SetString(PyExc_RuntimeError, "No simulator available!");
+        return NULL;
+    }
+
+    auto *obj = PyObject_New(gpi_hdl_Object<gpi_cb_group_hdl>,
+                             &gpi_hdl_Object<gpi_cb_group_hdl>::py_type);
+    if (obj == NULL) {
+        return NULL;
+    }
+    obj->cb_data = nullptr;
+    obj->hdl =
+        gpi_create_cb_group((gpi_function_t)handle_gpi_group_callback, obj);
+    return (PyObject *)obj;
+}
+
+static void cb_group_dealloc(PyObject *self) {
+    auto *obj = reinterpret_cast<gpi_hdl_Object<gpi_cb_group_hdl> *>(self);
+    gpi_destroy_cb_group(obj->hdl);
+    delete obj->cb_data;
+    Py_TYPE(self)->tp_free(self);
+}
+
+static PyObject *cb_group_add(gpi_hdl_Object<gpi_cb_group_hdl> *self,
+                              PyObject *pSigHdl) {
+    if (Py_TYPE(pSigHdl) != &gpi_hdl_Object<gpi_sim_hdl>::py_type) {
+        PyErr_Format(PyExc_TypeError,
+                     "add() argument must be cocotb.simulator.gpi_sim_hdl, "
+                     "not %.50s",
+                     Py_TYPE(pSigHdl)->tp_name);
+        return NULL;
+    }
+    gpi_sim_hdl sig_hdl = ((gpi_hdl_Object<gpi_sim_hdl> *)pSigHdl)->hdl;
+
+    int member = gpi_cb_group_add(self->hdl, sig_hdl);
+    if (member < 0) {
+        PyErr_SetString(PyExc_RuntimeError,
+                        "Failed to register a value change callback");
+        return NULL;
+    }
+    return PyLong_FromLong(member);
+}
+
+static PyObject *cb_group_remove(gpi_hdl_Object<gpi_cb_group_hdl> *self,
+                                 PyObject *arg) {
+    int member;
+    if (!parse_int(arg, member)) {
+        return NULL;
+    }
+    if (gpi_cb_group_remove(self->hdl, member)) {
+        PyErr_Format(PyExc_ValueError, "%d is not a member of the group",
+                     member);
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+// Remaining arguments are passed to the function when the group fires
+static PyObject *cb_group_arm(gpi_hdl_Object<gpi_cb_group_hdl> *self,
+                              FASTCALL_PARAMS) {
+    CHECK_NO_KWNAMES("arm");
+
+    if (nargs < 1) {
+        PyErr_SetString(PyExc_TypeError,
+                        "Attempt to arm value change group without "
+                        "enough arguments!\n");
+        return NULL;
+    }
+
+    PyObject *function = args[0];  // borrow reference
+    if (!PyCallable_Check(function)) {
+        PyErr_SetString(PyExc_TypeError,
+                        "Attempt to arm value change group without "
+                        "passing a callable callback!\n");
+        return NULL;
+    }
+
+    PyObject *fArgs = args_to_tuple(args + 1, nargs - 1);  // New reference
+    if (fArgs == NULL) {
+        return NULL;
+    }
+    DEFER(Py_DECREF(fArgs));
+
+    delete self->cb_data;
+    self->cb_data = new PythonCallback(function, fArgs, NULL);
+    gpi_cb_group_set_armed(self->hdl, true);
+    Py_RETURN_NONE;
+}
+
+static PyObject *cb_group_disarm(gpi_hdl_Object<gpi_cb_group_hdl> *self,
+                                 PyObject *) {
+    gpi_cb_group_set_armed(self->hdl, false);
+    delete self->cb_data;
+    self->cb_data = nullptr;
+    Py_RETURN_NONE;
+}
+
+static PyObject *cb_group_changed(gpi_hdl_Object<gpi_cb_group_hdl> *self,
+                                  PyObject *) {
+    const int *members;
+    size_t count = gpi_cb_group_get_changed(self->hdl, &members);
+
+    PyObject *list = PyList_New((Py_ssize_t)count);
+    if (list == NULL) {
+        return NULL;
+    }
+    for (size_t i = 0; i < count; i++) {
+        PyObject *member = PyLong_FromLong(members[i]);
+        if (member == NULL) {
+            Py_DECREF(list);
+            return NULL;
+        }
+        PyList_SET_ITEM(list, (Py_ssize_t)i, member);
+    }
+    return list;
+}
+
 static int add_module_constants(PyObject *simulator) {
     // Make the GPI constants accessible from the C world
     if (PyModule_AddIntConstant(simulator, "UNKNOWN", GPI_UNKNOWN) < 0 ||
@@ -1005,6 +2140,13 @@ static int add_module_constants(PyObject *simulator) {
         PyModule_AddIntConstant(simulator, "LOGIC", GPI_LOGIC) < 0 ||
         PyModule_AddIntConstant(simulator, "LOGIC_ARRAY", GPI_LOGIC_ARRAY) <
             0 ||
+        PyModule_AddIntConstant(simulator, "ARRAY_BINSTR", GPI_ARRAY_BINSTR) <
+            0 ||
+        PyModule_AddIntConstant(simulator, "ARRAY_UINT", GPI_ARRAY_UINT) < 0 ||
+        PyModule_AddIntConstant(simulator, "ARRAY_REAL", GPI_ARRAY_REAL) < 0 ||
+        PyModule_AddIntConstant(simulator, "MEM_BIN", GPI_MEM_BIN) < 0 ||
+        PyModule_AddIntConstant(simulator, "MEM_HEX", GPI_MEM_HEX) < 0 ||
+        PyModule_AddIntConstant(simulator, "MEM_ELF", GPI_MEM_ELF) < 0 ||
         false) {
         return -1;
     }
@@ -1037,6 +2179,13 @@ static int add_module_types(PyObject *simulator) {
         return -1;
     }
 
+    typ = (PyObject *)&object_info_type;
+    Py_INCREF(typ);
+    if (PyModule_AddObject(simulator, "gpi_object_info", typ) < 0) {
+        Py_DECREF(typ);
+        return -1;
+    }
+
     typ = (PyObject *)&gpi_hdl_Object<gpi_clk_hdl>::py_type;
     Py_INCREF(typ);
     if (PyModule_AddObject(simulator, "GpiClock", typ) < 0) {
@@ -1046,6 +2195,15 @@ static int add_module_types(PyObject *simulator) {
         // LCOV_EXCL_STOP
     }
 
+    typ = (PyObject *)&gpi_hdl_Object<gpi_cb_group_hdl>::py_type;
+    Py_INCREF(typ);
+    if (PyModule_AddObject(simulator, "gpi_cb_group", typ) < 0) {
+        // LCOV_EXCL_START
+        Py_DECREF(typ);
+        return -1;
+        // LCOV_EXCL_STOP
+    }
+
     return 0;
 }
 
@@ -1059,7 +2217,7 @@ static int add_module_types(PyObject *simulator) {
  */
 
 static PyMethodDef SimulatorMethods[] = {
-    {"get_root_handle", get_root_handle, METH_VARARGS,
+    {"get_root_handle", get_root_handle, METH_O,
      PyDoc_STR("get_root_handle(name, /)\n"
                "--\n\n"
                "get_root_handle(name: str) -> cocotb.simulator.gpi_sim_hdl\n"
@@ -1071,45 +2229,70 @@ static PyMethodDef SimulatorMethods[] = {
                "Get an iterator handle to loop over all HDL packages.\n"
                "\n"
                ".. versionadded:: 2.0")},
-    {"register_timed_callback", register_timed_callback, METH_VARARGS,
+    {"register_timed_callback", FASTCALL_METHOD(register_timed_callback),
+     METH_FASTCALL,
      PyDoc_STR("register_timed_callback(time, func, /, *args)\n"
                "--\n\n"
                "register_timed_callback(time: int, func: Callable[..., Any], "
                "*args: Any) -> cocotb.simulator.gpi_cb_hdl\n"
                "Register a timed callback.")},
-    {"register_value_change_callback", register_value_change_callback,
-     METH_VARARGS,
+    {"register_value_change_callback",
+     FASTCALL_METHOD(register_value_change_callback), METH_FASTCALL,
      PyDoc_STR("register_value_change_callback(signal, func, edge, /, *args)\n"
                "--\n\n"
                "register_value_change_callback(signal: "
                "cocotb.simulator.gpi_sim_hdl, func: Callable[..., Any], edge: "
                "int, *args: Any) -> cocotb.simulator.gpi_cb_hdl\n"
                "Register a signal change callback.")},
-    {"register_readonly_callback", register_readonly_callback, METH_VARARGS,
+    {"register_masked_value_change_callback",
+     FASTCALL_METHOD(register_masked_value_change_callback), METH_FASTCALL,
+     PyDoc_STR("register_masked_value_change_callback(signal, func, mask, "
+               "value, /, *args)\n"
+               "--\n\n"
+               "register_masked_value_change_callback(signal: "
+               "cocotb.simulator.gpi_sim_hdl, func: Callable[..., Any], mask: "
+               "str, value: Optional[str], *args: Any) -> "
+               "cocotb.simulator.gpi_cb_hdl\n"
+               "Register a signal change callback which only fires on changes "
+               "of the bits set in *mask*, and if *value* is given, only when "
+               "those bits reach the matching bits of *value*.\n"
+               "\n"
+               ".. versionadded:: 2.1")},
+    {"create_value_change_group", create_value_change_group, METH_NOARGS,
+     PyDoc_STR("create_value_change_group()\n"
+               "--\n\n"
+               "create_value_change_group() -> cocotb.simulator.gpi_cb_group\n"
+               "Create an empty, disarmed group of value change callbacks.\n"
+               "\n"
+               ".. versionadded:: 2.1")},
+    {"register_readonly_callback", FASTCALL_METHOD(register_readonly_callback),
+     METH_FASTCALL,
      PyDoc_STR("register_readonly_callback(func, /, *args)\n"
                "--\n\n"
                "register_readonly_callback(func: Callable[..., Any], *args: "
                "Any) -> cocotb.simulator.gpi_cb_hdl\n"
                "Register a callback for the read-only phase.")},
-    {"register_nextstep_callback", register_nextstep_callback, METH_VARARGS,
+    {"register_nextstep_callback", FASTCALL_METHOD(register_nextstep_callback),
+     METH_FASTCALL,
      PyDoc_STR("register_nextstep_callback(func, /, *args)\n"
                "--\n\n"
                "register_nextstep_callback(func: Callable[..., Any], *args: "
                "Any) -> cocotb.simulator.gpi_cb_hdl\n"
                "Register a callback for the cbNextSimTime callback.")},
-    {"register_rwsynch_callback", register_rwsynch_callback, METH_VARARGS,
+    {"register_rwsynch_callback", FASTCALL_METHOD(register_rwsynch_callback),
+     METH_FASTCALL,
      PyDoc_STR("register_rwsynch_callback(func, /, *args)\n"
                "--\n\n"
                "register_rwsynch_callback(func: Callable[..., Any], *args: "
                "Any) -> cocotb.simulator.gpi_cb_hdl\n"
                "Register a callback for the read-write phase.")},
-    {"stop_simulator", stop_simulator, METH_VARARGS,
+    {"stop_simulator", stop_simulator, METH_NOARGS,
      PyDoc_STR("stop_simulator()\n"
                "--\n\n"
                "stop_simulator() -> None\n"
                "Instruct the attached simulator to stop. Users should not call "
                "this function.")},
-    {"set_gpi_log_level", set_gpi_log_level, METH_VARARGS,
+    {"set_gpi_log_level", set_gpi_log_level, METH_O,
      PyDoc_STR("set_gpi_log_level(level, /)\n"
                "--\n\n"
                "set_gpi_log_level(level: int) -> None\n"
@@ -1147,7 +2330,7 @@ static PyMethodDef SimulatorMethods[] = {
                "--\n\n"
                "get_simulator_version() -> str\n"
                "Get the simulator's product version string.")},
-    {"clock_create", clock_create, METH_VARARGS,
+    {"clock_create", clock_create, METH_O,
      PyDoc_STR("clock_create(signal, /)\n"
                "--\n\n"
                "clock_create(signal: cocotb.simulator.gpi_sim_hdl"
@@ -1155,7 +2338,7 @@ static PyMethodDef SimulatorMethods[] = {
                "Create a clock driver on a signal.\n"
                "\n"
                ".. versionadded:: 2.0")},
-    {"initialize_logger", initialize_logger, METH_VARARGS,
+    {"initialize_logger", FASTCALL_METHOD(initialize_logger), METH_FASTCALL,
      PyDoc_STR("initialize_logger(log_func, /)\n"
                "--\n\n"
                "initialize_logger("
@@ -1163,12 +2346,176 @@ static PyMethodDef SimulatorMethods[] = {
                "get_logger: Callable[[str], Logger]"
                ") -> None\n"
                "Initialize the GPI logger with Python logging functions.")},
-    {"set_sim_event_callback", set_sim_event_callback, METH_VARARGS,
+    {"clear_logger_level_cache", clear_logger_level_cache, METH_NOARGS,
+     PyDoc_STR("clear_logger_level_cache()\n"
+               "--\n\n"
+               "clear_logger_level_cache() -> None\n"
+               "Forget the logger levels cached by the GPI logger.\n"
+               "\n"
+               "Must be called whenever the level of a Python logger changes.\n"
+               "\n"
+               ".. versionadded:: 2.1")},
+    {"set_sim_event_callback", set_sim_event_callback, METH_O,
      PyDoc_STR("set_sim_event_callback(sim_event_callback, /)\n"
                "--\n\n"
                "set_sim_event_callback(sim_event_callback: Callable[[str], "
                "None]) -> None\n"
                "Set the callback for simulator events.")},
+    {"get_stats", get_stats, METH_NOARGS,
+     PyDoc_STR("get_stats()\n"
+               "--\n\n"
+               "get_stats() -> Dict[str, Any]\n"
+               "Get a snapshot of the GPI performance counters.\n"
+               "\n"
+               "Returns a dictionary with per callback type counts, total time "
+               "and log2 nanosecond latency histograms under ``callbacks``; "
+               "the wall time spent in the GPI and in the simulator; signal "
+               "reads and writes by value format; the number of callbacks "
+               "which exceeded the slow callback threshold; any counters "
+               "kept by the simulator under ``simulator``; the number of "
+               "reads answered by the ReadOnly value cache; the number of "
+               "writes dropped by write elision; and the number of callbacks "
+               "delivered in batches.\n"
+               "\n"
+               ".. versionadded:: 2.1")},
+    {"reset_stats", reset_stats, METH_NOARGS,
+     PyDoc_STR("reset_stats()\n"
+               "--\n\n"
+               "reset_stats() -> None\n"
+               "Reset the GPI performance counters to zero.\n"
+               "\n"
+               ".. versionadded:: 2.1")},
+    {"get_memory_stats", get_memory_stats, METH_NOARGS,
+     PyDoc_STR("get_memory_stats()\n"
+               "--\n\n"
+               "get_memory_stats() -> Dict[str, int]\n"
+               "Get the memory used by GPI object handles.\n"
+               "\n"
+               "Returns a dictionary with the number of live ``handles`` and "
+               "the ``handle_bytes`` allocated for them, and the number of "
+               "``strings`` in the string table shared by the handles and "
+               "their ``string_bytes``.\n"
+               "\n"
+               ".. versionadded:: 2.1")},
+    {"set_slow_callback_threshold", set_slow_callback_threshold, METH_O,
+     PyDoc_STR("set_slow_callback_threshold(threshold_ns, /)\n"
+               "--\n\n"
+               "set_slow_callback_threshold(threshold_ns: int) -> None\n"
+               "Set the duration above which callbacks are counted and logged "
+               "as slow, ``0`` disables the check.\n"
+               "\n"
+               ".. versionadded:: 2.1")},
+    {"set_readonly_value_cache", set_readonly_value_cache, METH_O,
+     PyDoc_STR("set_readonly_value_cache(enable, /)\n"
+               "--\n\n"
+               "set_readonly_value_cache(enable: bool) -> None\n"
+               "Enable or disable caching of signal values read during "
+               "ReadOnly callbacks.\n"
+               "\n"
+               "Repeated reads of a signal in the same ReadOnly callback then "
+               "return the first value read without asking the simulator "
+               "again.\n"
+               "\n"
+               ".. versionadded:: 2.1")},
+    {"set_write_elision", set_write_elision, METH_O,
+     PyDoc_STR("set_write_elision(enable, /)\n"
+               "--\n\n"
+               "set_write_elision(enable: bool) -> None\n"
+               "Enable or disable dropping deposits which wouldn't change the "
+               "value of a signal.\n"
+               "\n"
+               "The last value deposited on a signal is kept until the signal "
+               "changes or is read, and depositing it again is skipped.\n"
+               "\n"
+               ".. versionadded:: 2.1")},
+    {"set_callback_batching", set_callback_batching, METH_O,
+     PyDoc_STR("set_callback_batching(handler, /)\n"
+               "--\n\n"
+               "set_callback_batching(handler: Optional[Callable[[List[Tuple["
+               "Callable[..., Any], Tuple[Any, ...]]]], None]]) -> None\n"
+               "Deliver callbacks which fire in the same dispatch of the "
+               "simulator harness in one call of *handler*.\n"
+               "\n"
+               "*handler* is called with a list of the ``(func, args)`` pairs "
+               "of the callbacks instead of calling each *func*. ``None`` "
+               "stops batching.\n"
+               "\n"
+               ".. versionadded:: 2.1")},
+    {"fork", fork_simulator, METH_NOARGS,
+     PyDoc_STR("fork()\n"
+               "--\n\n"
+               "fork() -> int\n"
+               "Fork the simulation process, if the simulator supports it.\n"
+               "\n"
+               "Returns the PID of the child in the parent and ``0`` in the "
+               "child, like :func:`os.fork`.\n"
+               "\n"
+               ".. versionadded:: 2.1")},
+    {"checkpoint_save", checkpoint_save, METH_O,
+     PyDoc_STR("checkpoint_save(filename, /)\n"
+               "--\n\n"
+               "checkpoint_save(filename: str) -> None\n"
+               "Save the simulation state to *filename* at the end of the "
+               "current time step, if the simulator supports it.\n"
+               "\n"
+               "Raises :exc:`RuntimeError` if checkpoints are unsupported or "
+               "*filename* can't be created.\n"
+               "\n"
+               ".. versionadded:: 2.1")},
+    {"set_waveform_dumping", set_waveform_dumping, METH_O,
+     PyDoc_STR("set_waveform_dumping(enable, /)\n"
+               "--\n\n"
+               "set_waveform_dumping(enable: bool) -> None\n"
+               "Start or stop dumping waveforms, if the simulator supports "
+               "it. The change takes effect immediately, so it also decides "
+               "whether the current time step is dumped.\n"
+               "\n"
+               ".. versionadded:: 2.1")},
+    {"get_signal_vals_real", FASTCALL_METHOD(get_signal_vals_real),
+     METH_FASTCALL,
+     PyDoc_STR("get_signal_vals_real(handles, buffer, /)\n"
+               "--\n\n"
+               "get_signal_vals_real(handles: Sequence[cocotb.simulator."
+               "gpi_sim_hdl], buffer: Any) -> None\n"
+               "Read the values of the real signals *handles* into a "
+               "writable buffer of doubles.\n"
+               "\n"
+               ".. versionadded:: 2.1")},
+    {"set_signal_vals_real", FASTCALL_METHOD(set_signal_vals_real),
+     METH_FASTCALL,
+     PyDoc_STR("set_signal_vals_real(action, handles, buffer, /)\n"
+               "--\n\n"
+               "set_signal_vals_real(action: int, handles: Sequence[cocotb."
+               "simulator.gpi_sim_hdl], buffer: Any) -> None\n"
+               "Set the values of the real signals *handles* from a buffer "
+               "of doubles.\n"
+               "\n"
+               ".. versionadded:: 2.1")},
+    {"load_memory", FASTCALL_METHOD(load_memory), METH_FASTCALL,
+     PyDoc_STR("load_memory(handle, path, format, offset=0, /)\n"
+               "--\n\n"
+               "load_memory(handle: cocotb.simulator.gpi_sim_hdl, path: str, "
+               "format: int, offset: int = 0) -> None\n"
+               "Load the memory image file *path* into the array *handle*.\n"
+               "\n"
+               "*format* is :data:`MEM_BIN`, :data:`MEM_HEX` or "
+               ":data:`MEM_ELF`. The element at image address ``0`` is "
+               "written to position *offset* from the left bound.\n"
+               "\n"
+               ".. versionadded:: 2.1")},
+    {"dump_memory", FASTCALL_METHOD(dump_memory), METH_FASTCALL,
+     PyDoc_STR("dump_memory(handle, path, format, offset=0, /)\n"
+               "--\n\n"
+               "dump_memory(handle: cocotb.simulator.gpi_sim_hdl, path: str, "
+               "format: int, offset: int = 0) -> None\n"
+               "Save the contents of the array *handle* to the memory image "
+               "file *path*.\n"
+               "\n"
+               "*format* is :data:`MEM_BIN` or :data:`MEM_HEX`. HEX images "
+               "start at the address of the left bound, which is "
+               "``-offset``. BIN images must have an *offset* of ``0``.\n"
+               "\n"
+               ".. versionadded:: 2.1")},
     {NULL, NULL, 0, NULL} /* Sentinel */
 };
 
@@ -1205,6 +2552,18 @@ PyMODINIT_FUNC PyInit_simulator(void) {
         return NULL;
         // LCOV_EXCL_STOP
     }
+    if (PyType_Ready(&gpi_hdl_Object<gpi_cb_group_hdl>::py_type) < 0) {
+        // LCOV_EXCL_START
+        return NULL;
+        // LCOV_EXCL_STOP
+    }
+
+    if (PyStructSequence_InitType2(&object_info_type, &object_info_desc) <
+        0) {
+        // LCOV_EXCL_START
+        return NULL;
+        // LCOV_EXCL_STOP
+    }
 
     PyObject *simulator = PyModule_Create(&moduledef);
     if (simulator == NULL) {
@@ -1255,23 +2614,42 @@ static PyMethodDef gpi_sim_hdl_methods[] = {
                "--\n\n"
                "get_signal_val_real() -> float\n"
                "Get the value of a signal as a float.")},
-    {"set_signal_val_int", (PyCFunction)set_signal_val_int, METH_VARARGS,
+    {"set_signal_val_int", FASTCALL_METHOD(set_signal_val_int), METH_FASTCALL,
      PyDoc_STR("set_signal_val_int($self, action, value, /)\n"
                "--\n\n"
                "set_signal_val_int(action: int, value: int) -> None\n"
                "Set the value of a signal using an int.")},
-    {"set_signal_val_str", (PyCFunction)set_signal_val_str, METH_VARARGS,
+    {"set_signal_val_str", FASTCALL_METHOD(set_signal_val_str), METH_FASTCALL,
      PyDoc_STR("set_signal_val_str($self, action, value, /)\n"
                "--\n\n"
                "set_signal_val_str(action: int, value: bytes) -> None\n"
                "Set the value of a signal using a user-encoded string.")},
-    {"set_signal_val_binstr", (PyCFunction)set_signal_val_binstr, METH_VARARGS,
+    {"set_signal_val_binstr", FASTCALL_METHOD(set_signal_val_binstr),
+     METH_FASTCALL,
      PyDoc_STR("set_signal_val_binstr($self, action, value, /)\n"
                "--\n\n"
                "set_signal_val_binstr(action: int, value: str) -> None\n"
                "Set the value of a logic vector signal using a string of "
                "(``0``, ``1``, ``X``, etc.), one element per character.")},
-    {"set_signal_val_real", (PyCFunction)set_signal_val_real, METH_VARARGS,
+    {"get_signal_slice", FASTCALL_METHOD(get_signal_slice), METH_FASTCALL,
+     PyDoc_STR("get_signal_slice($self, left, right, /)\n"
+               "--\n\n"
+               "get_signal_slice(left: int, right: int) -> str\n"
+               "Get the value of the bits *left* to *right* of a logic vector "
+               "signal as a string of (``0``, ``1``, ``X``, etc.).\n"
+               "\n"
+               ".. versionadded:: 2.1")},
+    {"set_signal_slice", FASTCALL_METHOD(set_signal_slice), METH_FASTCALL,
+     PyDoc_STR("set_signal_slice($self, action, left, right, value, /)\n"
+               "--\n\n"
+               "set_signal_slice(action: int, left: int, right: int, value: "
+               "str) -> None\n"
+               "Set the value of the bits *left* to *right* of a logic vector "
+               "signal, keeping the value of the other bits.\n"
+               "\n"
+               ".. versionadded:: 2.1")},
+    {"set_signal_val_real", FASTCALL_METHOD(set_signal_val_real),
+     METH_FASTCALL,
      PyDoc_STR("set_signal_val_real($self, action, value, /)\n"
                "--\n\n"
                "set_signal_val_real(action: int, value: float) -> None\n"
@@ -1286,7 +2664,7 @@ static PyMethodDef gpi_sim_hdl_methods[] = {
                "--\n\n"
                "get_definition_file() -> str\n"
                "Get the file that sources the object's definition.")},
-    {"get_handle_by_name", (PyCFunction)get_handle_by_name, METH_VARARGS,
+    {"get_handle_by_name", FASTCALL_METHOD(get_handle_by_name), METH_FASTCALL,
      PyDoc_STR(
          "get_handle_by_name($self, name, discovery_method/)\n"
          "--\n\n"
@@ -1296,7 +2674,7 @@ static PyMethodDef gpi_sim_hdl_methods[] = {
          "Get a handle to a child object by name.\n"
          "Specify *discovery_method* to determine the signal discovery "
          "strategy. :data:`~cocotb.handle.GPIDiscovery.AUTO` by default.")},
-    {"get_handle_by_index", (PyCFunction)get_handle_by_index, METH_VARARGS,
+    {"get_handle_by_index", (PyCFunction)get_handle_by_index, METH_O,
      PyDoc_STR(
          "get_handle_by_index($self, index, /)\n"
          "--\n\n"
@@ -1340,7 +2718,55 @@ static PyMethodDef gpi_sim_hdl_methods[] = {
                "--\n\n"
                "get_indexable() -> bool\n"
                "Return ``True`` if indexable.")},
-    {"iterate", (PyCFunction)iterate, METH_VARARGS,
+    {"get_info", (PyCFunction)get_info, METH_NOARGS,
+     PyDoc_STR("get_info($self)\n"
+               "--\n\n"
+               "get_info() -> cocotb.simulator.gpi_object_info\n"
+               "Get all the properties of an object in one call.\n"
+               "\n"
+               "Returns a named tuple of the values returned by "
+               ":meth:`get_type`, :meth:`get_type_string`, "
+               ":meth:`get_name_string`, :meth:`get_const`, "
+               ":meth:`get_indexable`, :meth:`get_num_elems`, "
+               ":meth:`get_range`, :meth:`get_definition_name` and "
+               ":meth:`get_definition_file`.\n"
+               "\n"
+               ".. versionadded:: 2.1")},
+    {"get_array_element_width", (PyCFunction)get_array_element_width,
+     METH_NOARGS,
+     PyDoc_STR("get_array_element_width($self)\n"
+               "--\n\n"
+               "get_array_element_width() -> int\n"
+               "Get the width in bits of the elements of an array, or ``-1`` "
+               "if the elements are not signals.\n"
+               "\n"
+               ".. versionadded:: 2.1")},
+    {"read_array", FASTCALL_METHOD(read_array), METH_FASTCALL,
+     PyDoc_STR("read_array($self, first, count, format, buffer, /)\n"
+               "--\n\n"
+               "read_array(first: int, count: int, format: int, buffer: "
+               "Buffer) -> None\n"
+               "Read *count* elements of an array starting at index *first* "
+               "into a writable buffer, without creating a handle for each "
+               "element.\n"
+               "\n"
+               "*format* is :data:`ARRAY_BINSTR`, :data:`ARRAY_UINT` or "
+               ":data:`ARRAY_REAL`.\n"
+               "\n"
+               ".. versionadded:: 2.1")},
+    {"write_array", FASTCALL_METHOD(write_array), METH_FASTCALL,
+     PyDoc_STR("write_array($self, action, first, count, format, buffer, /)\n"
+               "--\n\n"
+               "write_array(action: int, first: int, count: int, format: int, "
+               "buffer: Buffer) -> None\n"
+               "Write *count* elements of an array starting at index *first* "
+               "from a buffer, without creating a handle for each element.\n"
+               "\n"
+               "*format* is :data:`ARRAY_BINSTR`, :data:`ARRAY_UINT` or "
+               ":data:`ARRAY_REAL`.\n"
+               "\n"
+               ".. versionadded:: 2.1")},
+    {"iterate", (PyCFunction)iterate, METH_O,
      PyDoc_STR(
          "iterate($self, mode, /)\n"
          "--\n\n"
@@ -1350,7 +2776,6 @@ static PyMethodDef gpi_sim_hdl_methods[] = {
 };
 
 // putting these at the bottom means that all the functions above are accessible
-template <>
 PyTypeObject gpi_hdl_Object<gpi_sim_hdl>::py_type = []() -> PyTypeObject {
     auto type = fill_common_slots<gpi_sim_hdl>();
     type.tp_name = "cocotb.simulator.gpi_sim_hdl";
@@ -1360,16 +2785,17 @@ PyTypeObject gpi_hdl_Object<gpi_sim_hdl>::py_type = []() -> PyTypeObject {
         "Contains methods for getting and setting the value of a GPI object, "
         "and introspection.";
     type.tp_methods = gpi_sim_hdl_methods;
+    type.tp_dealloc = gpi_sim_hdl_dealloc;
     return type;
 }();
 
-template <>
 PyTypeObject gpi_hdl_Object<gpi_iterator_hdl>::py_type = []() -> PyTypeObject {
     auto type = fill_common_slots<gpi_iterator_hdl>();
     type.tp_name = "cocotb.simulator.gpi_iterator_hdl";
     type.tp_doc = "GPI iterator handle.";
     type.tp_iter = PyObject_SelfIter;
     type.tp_iternext = (iternextfunc)next;
+    type.tp_dealloc = gpi_iterator_hdl_dealloc;
     return type;
 }();
 
@@ -1392,7 +2818,7 @@ PyTypeObject gpi_hdl_Object<gpi_cb_hdl>::py_type = []() -> PyTypeObject {
 }();
 
 static PyMethodDef gpi_clk_methods[] = {
-    {"start", (PyCFunction)clk_start, METH_VARARGS,
+    {"start", FASTCALL_METHOD(clk_start), METH_FASTCALL,
      PyDoc_STR(
          "start($self, period_steps, high_steps, start_high)\n"
          "--\n\n"
@@ -1431,3 +2857,52 @@ PyTypeObject gpi_hdl_Object<gpi_clk_hdl>::py_type = []() -> PyTypeObject {
     type.tp_dealloc = clock_dealloc;
     return type;
 }();
+
+static PyMethodDef gpi_cb_group_methods[] = {
+    {"add", (PyCFunction)cb_group_add, METH_O,
+     PyDoc_STR("add($self, signal, /)\n"
+               "--\n\n"
+               "add(signal: cocotb.simulator.gpi_sim_hdl) -> int\n"
+               "Register a value change callback on *signal*, "
+               "returning its member identifier.\n"
+               "\n"
+               "Raises:\n"
+               "    RuntimeError: If the callback could not be registered.")},
+    {"remove", (PyCFunction)cb_group_remove, METH_O,
+     PyDoc_STR("remove($self, member, /)\n"
+               "--\n\n"
+               "remove(member: int) -> None\n"
+               "Remove the value change callback of *member*.\n"
+               "\n"
+               "Raises:\n"
+               "    ValueError: If *member* is not in the group.")},
+    {"arm", FASTCALL_METHOD(cb_group_arm), METH_FASTCALL,
+     PyDoc_STR("arm($self, func, /, *args)\n"
+               "--\n\n"
+               "arm(func: Callable[..., Any], *args: Any) -> None\n"
+               "Call *func* with *args* once, in the next ReadWrite phase "
+               "after any member changes.")},
+    {"disarm", (PyCFunction)cb_group_disarm, METH_NOARGS,
+     PyDoc_STR("disarm($self)\n"
+               "--\n\n"
+               "disarm() -> None\n"
+               "Stop collecting changes, dropping those collected so far and "
+               "the callback.")},
+    {"changed", (PyCFunction)cb_group_changed, METH_NOARGS,
+     PyDoc_STR("changed($self)\n"
+               "--\n\n"
+               "changed() -> list[int]\n"
+               "Get the members which changed before the group last fired.")},
+    {NULL, NULL, 0, NULL} /* Sentinel */
+};
+
+PyTypeObject gpi_hdl_Object<gpi_cb_group_hdl>::py_type = []() -> PyTypeObject {
+    auto type = fill_common_slots<gpi_cb_group_hdl>();
+    type.tp_name = "cocotb.simulator.gpi_cb_group";
+    type.tp_doc =
+        "GPI value change callbacks on a set of signals, which fire together "
+        "once per time step.";
+    type.tp_methods = gpi_cb_group_methods;
+    type.tp_dealloc = cb_group_dealloc;
+    return type;
+}();
@@ -3,13 +3,20 @@
 // SPDX-License-Identifier: BSD-3-Clause
 
 #include <libgen.h>  // basename
+#ifdef __linux__
+#include <sched.h>  // sched_setaffinity
+#endif
 #include <stdio.h>   // stderr, fprintf
+#include <stdlib.h>  // strtoul
+#include <unistd.h>  // getpid
 
 #include <memory>  // std::unique_ptr
 #include <string>  // std::string
+#include <vector>  // std::vector
 
 #include "Vtop.h"
 #include "verilated.h"
+#include "verilated_syms.h"
 #include "verilated_vpi.h"
 
 #ifndef VM_TRACE_FST
@@ -26,8 +33,19 @@ using verilated_trace_t = VerilatedFstC;
 using verilated_trace_t = VerilatedVcdC;
 #endif
 static verilated_trace_t *tfp;
+static std::string trace_file_name;
+static int trace_depth = 99;
+static std::vector<std::string> trace_scopes;
+// Whether the current time step is dumped, toggled by the trace window or
+// on request from cocotb
+static bool trace_dumping = false;
+#endif
+
+#ifdef COCOTB_VERILATOR_SAVABLE
+#include <verilated_save.h>
 #endif
 
+static Vtop *top_model;
 static vluint64_t main_time = 0;  // Current simulation time
 
 double sc_time_stamp() {  // Called by $time in Verilog
@@ -37,6 +55,127 @@ double sc_time_stamp() {  // Called by $time in Verilog
 
 extern "C" {
 void vlog_startup_routines_bootstrap(void);
+void vpi_verilator_set_direct_access(
+    bool (*resolver)(const char *fullname, void **datap, int *container_bytes,
+                     bool *writable),
+    void (*eval_needed)(void));
+void vpi_verilator_do_direct_puts(void);
+bool vpi_verilator_take_writes(void);
+void gpi_enable_fork(void (*prepare)(void), void (*child)(void));
+void gpi_enable_checkpoint(int (*save)(const char *filename));
+void gpi_enable_waveform_control(int (*set_dumping)(bool enable));
+void gpi_register_sim_counters(const char *const *names, uint64_t *values,
+                               size_t count);
+void gpi_begin_callback_batch(void);
+void gpi_end_callback_batch(void);
+}
+
+// Counters of the work done in each phase of the main loop, reported by
+// cocotb.simulator.get_stats(). Phases only count when callbacks ran.
+enum {
+    TIME_STEPS,
+    IDLE_TIME_STEPS,
+    EVALS,
+    VALUE_SETTLES,
+    VALUE_SETTLES_SKIPPED,
+    READWRITE_PHASES,
+    READONLY_PHASES,
+    NEXTTIME_PHASES,
+    TIMED_PHASES,
+    NUM_COUNTERS
+};
+static const char *const counter_names[NUM_COUNTERS] = {
+    "time_steps",
+    "idle_time_steps",
+    "evals",
+    "value_settles",
+    "value_settles_skipped",
+    "readwrite_phases",
+    "readonly_phases",
+    "nexttime_phases",
+    "timed_phases",
+};
+static uint64_t counters[NUM_COUNTERS];
+
+// Skip work in time steps where nothing can have changed
+static bool fast_forward = true;
+
+// Set when cocotb writes model storage directly rather than through VPI
+static bool direct_eval_needed = false;
+
+static void set_direct_eval_needed() { direct_eval_needed = true; }
+
+// Resolve a VPI full name the same way vpi_handle_by_name() does, giving
+// cocotb direct access to the variable's storage.
+static bool resolve_var(const char *fullname, void **datap,
+                        int *container_bytes, bool *writable) {
+    std::string name(fullname);
+    auto dot = name.rfind('.');
+    if (dot == std::string::npos) {
+        return false;
+    }
+    const VerilatedScope *scopep =
+        Verilated::threadContextp()->scopeFind(name.substr(0, dot).c_str());
+    if (!scopep) {
+        return false;
+    }
+    const VerilatedVar *varp = scopep->varFind(name.substr(dot + 1).c_str());
+    if (!varp || varp->isParam() || varp->udims() != 0) {
+        return false;
+    }
+    switch (varp->vltype()) {
+        case VLVT_UINT8:
+            *container_bytes = 1;
+            break;
+        case VLVT_UINT16:
+            *container_bytes = 2;
+            break;
+        case VLVT_UINT32:
+            *container_bytes = 4;
+            break;
+        case VLVT_UINT64:
+            *container_bytes = 8;
+            break;
+        case VLVT_WDATA:
+            *container_bytes = 0;
+            break;
+        default:
+            return false;
+    }
+    *datap = varp->datap();
+    *writable = varp->isPublicRW();
+    return true;
+}
+
+static inline void do_inertial_puts() {
+    VerilatedVpi::doInertialPuts();
+    vpi_verilator_do_direct_puts();
+}
+
+static inline bool eval_needed() {
+    return VerilatedVpi::evalNeeded() || direct_eval_needed;
+}
+
+static inline void clear_eval_needed() {
+    VerilatedVpi::clearEvalNeeded();
+    direct_eval_needed = false;
+}
+
+// Deliver all the callbacks fired by one dispatch to cocotb together
+template <typename F>
+static inline bool call_batched(F call) {
+    gpi_begin_callback_batch();
+    bool cbs_called = call();
+    gpi_end_callback_batch();
+    return cbs_called;
+}
+
+static inline bool call_value_cbs() {
+    return call_batched([] { return VerilatedVpi::callValueCbs(); });
+}
+
+static inline bool call_cbs(uint32_t reason) {
+    return call_batched([reason] { return VerilatedVpi::callCbs(reason); });
 }
 
 static inline bool settle_value_callbacks() {
@@ -45,14 +184,163 @@ static inline bool settle_value_callbacks() {
     // Call Value Change callbacks
     // These can modify signal values so we loop
     // until there are no more changes
-    cbs_called = again = VerilatedVpi::callValueCbs();
+    cbs_called = again = call_value_cbs();
     while (again) {
-        again = VerilatedVpi::callValueCbs();
+        again = call_value_cbs();
     }
+    counters[VALUE_SETTLES]++;
 
     return cbs_called;
 }
 
+// Values can only have changed since the last settle if something was written
+static inline void settle_value_callbacks_if_written() {
+    if (!fast_forward || eval_needed()) {
+        settle_value_callbacks();
+    } else {
+        counters[VALUE_SETTLES_SKIPPED]++;
+    }
+}
+
+#if VM_TRACE
+static void open_trace(const char *filename) {
+    tfp = new verilated_trace_t;
+    // Scopes must be selected before the trace is attached to the model
+    for (const auto &scope : trace_scopes) {
+        tfp->dumpvars(trace_depth, scope);
+    }
+    top_model->trace(tfp, trace_scopes.empty() ? trace_depth : 99);
+    tfp->open(filename);
+}
+
+static int set_trace_dumping(bool enable) {
+    if (enable && !tfp) {
+        // Tracing was not requested on the command line, so start it now
+        open_trace(trace_file_name.c_str());
+    }
+    if (!enable && trace_dumping) {
+        tfp->flush();
+    }
+    trace_dumping = enable;
+    return 0;
+}
+#endif
+
+static void fork_prepare() {
+#if VM_TRACE
+    if (tfp) {
+        tfp->flush();
+    }
+#endif
+}
+
+static void fork_child() {
+#if VM_TRACE
+    if (tfp) {
+        // The inherited trace still belongs to the parent, so leave it alone
+        // and dump the rest of this child's run to its own file, e.g.
+        // dump.1234.vcd
+        std::string name = trace_file_name;
+        std::string pid = "." + std::to_string(getpid());
+        auto dot = name.rfind('.');
+        if (dot == std::string::npos || dot < name.rfind('/') + 1) {
+            name += pid;
+        } else {
+            name.insert(dot, pid);
+        }
+        open_trace(name.c_str());
+    }
+#endif
+}
+
+#ifdef COCOTB_VERILATOR_SAVABLE
+// Checkpoint requested by cocotb, saved once the current time step is done.
+// The file is opened straight away, so that failing to open it is reported
+// to the caller.
+static VerilatedSave *checkpoint_request = nullptr;
+
+static int request_checkpoint(const char *filename) {
+    auto *os = new VerilatedSave;
+    os->open(filename);
+    if (!os->isOpen()) {
+        delete os;
+        return -1;
+    }
+    delete checkpoint_request;
+    checkpoint_request = os;
+    return 0;
+}
+
+// Only the model and the time are saved. cocotb is started afresh when a
+// checkpoint is restored, so no callbacks are pending at that point.
+static void save_checkpoint(VerilatedSave &os) {
+    os << main_time;
+    os << *top_model;
+    os.close();
+}
+
+static bool restore_checkpoint(const char *filename) {
+    VerilatedRestore os;
+    os.open(filename);
+    if (!os.isOpen()) {
+        fprintf(stderr, "Error: Unable to open checkpoint file %s\n",
+                filename);
+        return false;
+    }
+    os >> main_time;
+    os >> *top_model;
+    return true;
+}
+#endif
+
+// Restrict the simulator, and so all model threads created afterwards, to a
+// list of CPUs such as "0-3,8"
+static bool set_cpu_affinity(const char *cpus) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    const char *p = cpus;
+    while (*p) {
+        char *end;
+        unsigned long first = strtoul(p, &end, 10);
+        unsigned long last = first;
+        if (end == p) {
+            return false;
+        }
+        if (*end == '-') {
+            p = end + 1;
+            last = strtoul(p, &end, 10);
+            if (end == p || last < first) {
+                return false;
+            }
+        }
+        if (last >= CPU_SETSIZE) {
+            return false;
+        }
+        for (unsigned long cpu = first; cpu <= last; cpu++) {
+            CPU_SET(cpu, &set);
+        }
+        if (*end == ',') {
+            end++;
+        } else if (*end) {
+            return false;
+        }
+        p = end;
+    }
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    (void)cpus;
+    fprintf(stderr, "Error: --cpu-affinity is only supported on Linux\n");
+    return false;
+#endif
+}
+
+static bool parse_number(const char *str, unsigned long long &value) {
+    char *end;
+    value = strtoull(str, &end, 10);
+    return end != str && !*end;
+}
+
 void wrap_up() {
     VerilatedVpi::callCbs(cbEndOfSimulation);
 
@@ -79,6 +367,14 @@ int main(int argc, char **argv) {
 #endif
     bool traceOn = false;
     bool traceFlush = false;
+    unsigned long long traceStart = 0;
+    unsigned long long traceStop = ~0ULL;
+    bool forkServer = false;
+    unsigned threads = 0;
+    const char *cpuAffinity = nullptr;
+#ifdef COCOTB_VERILATOR_SAVABLE
+    const char *restoreFile = nullptr;
+#endif
 
     for (int i = 1; i < argc; i++) {
         std::string arg = std::string(argv[i]);
@@ -93,6 +389,49 @@ int main(int argc, char **argv) {
 #endif
         } else if (arg == "--trace-flush") {
             traceFlush = true;
+        } else if (arg == "--trace-start" || arg == "--trace-stop") {
+            unsigned long long &time =
+                arg == "--trace-start" ? traceStart : traceStop;
+            if (++i >= argc || !parse_number(argv[i], time)) {
+                fprintf(stderr, "Error: %s requires a time in steps\n",
+                        arg.c_str());
+                return -1;
+            }
+#if !VM_TRACE
+            fprintf(stderr,
+                    "Warning: %s has no effect as the design was built "
+                    "without trace support\n",
+                    arg.c_str());
+#endif
+        } else if (arg == "--trace-depth") {
+#if VM_TRACE
+            unsigned long long depth;
+            if (++i >= argc || !parse_number(argv[i], depth) || depth == 0) {
+                fprintf(stderr,
+                        "Error: --trace-depth requires a positive number\n");
+                return -1;
+            }
+            trace_depth = static_cast<int>(std::min(depth, 99ULL));
+#else
+            fprintf(stderr,
+                    "Error: --trace-depth requires the design to be built "
+                    "with trace support\n");
+            return -1;
+#endif
+        } else if (arg == "--trace-scope") {
+#if VM_TRACE
+            if (++i < argc) {
+                trace_scopes.emplace_back(argv[i]);
+            } else {
+                fprintf(stderr, "Error: --trace-scope requires a parameter\n");
+                return -1;
+            }
+#else
+            fprintf(stderr,
+                    "Error: --trace-scope requires the design to be built "
+                    "with trace support\n");
+            return -1;
+#endif
         } else if (arg == "--trace-file") {
             if (++i < argc) {
                 traceFile = argv[i];
@@ -100,28 +439,109 @@ int main(int argc, char **argv) {
                 fprintf(stderr, "Error: --trace-file requires a parameter\n");
                 return -1;
             }
+        } else if (arg == "--fork-server") {
+            forkServer = true;
+        } else if (arg == "--no-fast-forward") {
+            fast_forward = false;
+        } else if (arg == "--threads") {
+            unsigned long long count;
+            if (++i >= argc || !parse_number(argv[i], count) || count == 0) {
+                fprintf(stderr,
+                        "Error: --threads requires a positive number\n");
+                return -1;
+            }
+            threads = static_cast<unsigned>(count);
+        } else if (arg == "--cpu-affinity") {
+            if (++i < argc) {
+                cpuAffinity = argv[i];
+            } else {
+                fprintf(stderr,
+                        "Error: --cpu-affinity requires a parameter\n");
+                return -1;
+            }
+        } else if (arg == "--restore") {
+#ifdef COCOTB_VERILATOR_SAVABLE
+            if (++i < argc) {
+                restoreFile = argv[i];
+            } else {
+                fprintf(stderr, "Error: --restore requires a parameter\n");
+                return -1;
+            }
+#else
+            fprintf(stderr,
+                    "Error: --restore requires the design to be built with "
+                    "--savable\n");
+            return -1;
+#endif
         } else if (arg == "--help") {
             fprintf(
                 stderr,
-                "usage: %s [--trace] [--trace-flush] [--trace-file TRACEFILE]\n"
+                "usage: %s [--trace] [--trace-flush] [--trace-file TRACEFILE] "
+                "[--trace-start TIME] [--trace-stop TIME] [--trace-depth N] "
+                "[--trace-scope SCOPE]... [--fork-server] [--threads N] "
+                "[--cpu-affinity CPUS] [--restore FILE] [--no-fast-forward]\n"
                 "\n"
                 "cocotb + Verilator sim\n"
                 "\n"
                 "options:\n"
-                "  --trace       Enable tracing (VCD or FST)\n"
-                "  --trace-flush Flush trace at each time step (slow)\n"
-                "  --trace-file  Specify the trace file name (%s by "
-                "default)\n",
+                "  --trace         Enable tracing (VCD or FST)\n"
+                "  --trace-flush   Flush trace at each time step (slow)\n"
+                "  --trace-file    Specify the trace file name (%s by "
+                "default)\n"
+                "  --trace-start   Start dumping at this time in steps (0 by "
+                "default)\n"
+                "  --trace-stop    Stop dumping after this time in steps\n"
+                "  --trace-depth   Number of hierarchy levels to trace (below "
+                "each scope)\n"
+                "  --trace-scope   Only trace this scope, can be given more "
+                "than once\n"
+                "  --fork-server   Allow cocotb to fork the simulation to run "
+                "tests in parallel\n"
+                "  --threads       Number of threads for models built with "
+                "--threads\n"
+                "  --cpu-affinity  Run on the given CPUs only, e.g. 0-3,8 "
+                "(Linux only)\n"
+                "  --restore       Start from a checkpoint saved by cocotb "
+                "(requires --savable)\n"
+                "  --no-fast-forward\n"
+                "                  Evaluate the model in every time step, even "
+                "if idle\n",
                 basename(argv[0]), traceFile);
             return 0;
         }
     }
 
+    // Before the model and its thread pool are created, so the threads
+    // inherit the affinity
+    if (cpuAffinity && !set_cpu_affinity(cpuAffinity)) {
+        fprintf(stderr, "Error: Unable to set the CPU affinity to %s\n",
+                cpuAffinity);
+        return -1;
+    }
+
     Verilated::commandArgs(argc, argv);
 #ifdef VERILATOR_SIM_DEBUG
     Verilated::debug(99);
 #endif
+    if (threads) {
+        Verilated::threadContextp()->threads(threads);
+    }
     std::unique_ptr<Vtop> top(new Vtop(""));
+    top_model = top.get();
+
+    // The model's worker threads would not exist in a forked child
+    if (forkServer && top->threads() > 1) {
+        fprintf(stderr,
+                "Error: --fork-server is not supported with multi-threaded "
+                "models\n");
+        return -1;
+    }
+
+#ifdef COCOTB_VERILATOR_SAVABLE
+    if (restoreFile && !restore_checkpoint(restoreFile)) {
+        return -1;
+    }
+#endif
     Verilated::fatalOnVpiError(false);  // otherwise it will fail on systemtf
 
 #ifdef VERILATOR_SIM_DEBUG
@@ -130,48 +550,100 @@ int main(int argc, char **argv) {
 
 #if VM_TRACE
     Verilated::traceEverOn(true);
+    trace_file_name = traceFile;
     if (traceOn) {
-        tfp = new verilated_trace_t;
-        top->trace(tfp, 99);
-        tfp->open(traceFile);
+        open_trace(traceFile);
     }
+    // Dumping only starts with the trace window, or when cocotb asks for it
+    // if tracing was not turned on
+    bool traceStartPending = traceOn;
+    bool traceStopPending = traceOn && traceStop != ~0ULL;
 #endif
 
+    vpi_verilator_set_direct_access(resolve_var, set_direct_eval_needed);
+    if (forkServer) {
+        gpi_enable_fork(fork_prepare, fork_child);
+    }
+#ifdef COCOTB_VERILATOR_SAVABLE
+    gpi_enable_checkpoint(request_checkpoint);
+#endif
+#if VM_TRACE
+    gpi_enable_waveform_control(set_trace_dumping);
+#endif
+    gpi_register_sim_counters(counter_names, counters, NUM_COUNTERS);
     vlog_startup_routines_bootstrap();
     Verilated::addExitCb([](void *) { wrap_up(); }, nullptr);
     VerilatedVpi::callCbs(cbStartOfSimulation);
     settle_value_callbacks();
 
+    bool firstStep = true;
     while (!Verilated::gotFinish()) {
+        counters[TIME_STEPS]++;
+
+        // When cocotb wrote nothing and the design has nothing scheduled in
+        // this time step, e.g. when only cocotb timers are pending, evaluating
+        // the model can't change anything and is skipped
+        bool written = vpi_verilator_take_writes() || eval_needed();
+        bool evaluate =
+            !fast_forward || firstStep || written ||
+            (top->eventsPending() && top->nextTimeSlot() <= main_time);
+        firstStep = false;
+        if (!evaluate) {
+            counters[IDLE_TIME_STEPS]++;
+        }
+
         do {
             // We must evaluate whole design until we process all 'events' for
             // this time step
-            do {
+            while (evaluate) {
                 top->eval_step();
-                VerilatedVpi::clearEvalNeeded();
-                VerilatedVpi::doInertialPuts();
+                counters[EVALS]++;
+                clear_eval_needed();
+                do_inertial_puts();
                 settle_value_callbacks();
-            } while (VerilatedVpi::evalNeeded());
+                evaluate = eval_needed();
+            }
 
             // Run ReadWrite callback as we are done processing this eval step
-            VerilatedVpi::callCbs(cbReadWriteSynch);
-            VerilatedVpi::doInertialPuts();
-            settle_value_callbacks();
-        } while (VerilatedVpi::evalNeeded());
+            if (call_cbs(cbReadWriteSynch)) {
+                counters[READWRITE_PHASES]++;
+            }
+            do_inertial_puts();
+            settle_value_callbacks_if_written();
+            evaluate = true;
+        } while (eval_needed());
 
         top->eval_end_step();
 
         // Call ReadOnly callbacks
-        VerilatedVpi::callCbs(cbReadOnlySynch);
+        if (call_cbs(cbReadOnlySynch)) {
+            counters[READONLY_PHASES]++;
+        }
 
 #if VM_TRACE
-        if (tfp) {
+        if (traceStartPending && main_time >= traceStart) {
+            traceStartPending = false;
+            set_trace_dumping(true);
+        }
+        if (traceStopPending && main_time > traceStop) {
+            traceStopPending = false;
+            set_trace_dumping(false);
+        }
+        if (trace_dumping) {
             tfp->dump(main_time);
             if (traceFlush) {
                 tfp->flush();
             }
         }
 #endif
+
+#ifdef COCOTB_VERILATOR_SAVABLE
+        if (checkpoint_request) {
+            save_checkpoint(*checkpoint_request);
+            delete checkpoint_request;
+            checkpoint_request = nullptr;
+        }
+#endif
         // cocotb controls the clock inputs using cbAfterDelay so
         // skip ahead to the next registered callback
         const vluint64_t NO_TOP_EVENTS_PENDING = static_cast<vluint64_t>(~0ULL);
@@ -191,14 +663,18 @@ int main(int argc, char **argv) {
         // Call registered NextSimTime
         // It should be called in simulation cycle before everything else
         // but not on first cycle
-        VerilatedVpi::callCbs(cbNextSimTime);
-        settle_value_callbacks();
+        if (call_cbs(cbNextSimTime)) {
+            counters[NEXTTIME_PHASES]++;
+        }
+        settle_value_callbacks_if_written();
 
         // Call registered timed callbacks (e.g. clock timer)
         // These are called at the beginning of the time step
         // before the iterative regions (IEEE 1800-2012 4.4.1)
-        VerilatedVpi::callTimedCbs();
-        settle_value_callbacks();
+        if (call_batched([] { return VerilatedVpi::callTimedCbs(); })) {
+            counters[TIMED_PHASES]++;
+        }
+        settle_value_callbacks_if_written();
     }
 
     top->final();
@@ -11,16 +11,29 @@
 
 #include "VhpiImpl.h"
 #include "_vendor/vhpi/vhpi_user.h"
+#include "cocotb_utils.h"
+#include "gpi_probes.h"
 
 namespace {
 using bufSize_type = decltype(vhpiValueT::bufSize);
 }
 
+static inline uint64_t cb_sim_time(const vhpiCbDataT *cb_data) {
+    if (cb_data->time) {
+        return ((uint64_t)cb_data->time->high << 32) | cb_data->time->low;
+    }
+    return 0;
+}
+
 // Main entry point for callbacks from simulator
 void handle_vhpi_callback(const vhpiCbDataT *cb_data) {
-    gpi_to_user();
-
+    // cb_data may not outlive the callback, so copy what the probes need
+    int32_t reason = cb_data->reason;
     VhpiCbHdl *cb_hdl = (VhpiCbHdl *)cb_data->user_data;
+    GPI_PROBE3(vhpi_callback, reason, cb_hdl, cb_sim_time(cb_data));
+    DEFER(GPI_PROBE2(vhpi_callback_return, reason, cb_hdl));
+
+    gpi_to_user();
 
     // LCOV_EXCL_START
     if (!cb_hdl) {
@@ -39,17 +52,19 @@ void handle_vhpi_callback(const vhpiCbDataT *cb_data) {
 }
 
 VhpiArrayObjHdl::~VhpiArrayObjHdl() {
-    LOG_DEBUG("VHPI: Releasing VhpiArrayObjHdl handle for %s at %p",
-              get_fullname_str(), (void *)get_handle<vhpiHandleT>());
-    if (vhpi_release_handle(get_handle<vhpiHandleT>())) check_vhpi_error();
+    if (!shares_handle()) {
+        LOG_DEBUG("VHPI: Releasing VhpiArrayObjHdl handle for %s at %p",
+                  get_name_str(), (void *)get_handle<vhpiHandleT>());
+        if (vhpi_release_handle(get_handle<vhpiHandleT>())) check_vhpi_error();
+    }
 }
 
 VhpiObjHdl::~VhpiObjHdl() {
     /* Don't release handles for pseudo-regions, as they borrow the handle of
      * the containing region */
-    if (m_type != GPI_GENARRAY) {
+    if (m_type != GPI_GENARRAY && !shares_handle()) {
         LOG_DEBUG("VHPI: Releasing VhpiObjHdl handle for %s at %p",
-                  get_fullname_str(), (void *)get_handle<vhpiHandleT>());
+                  get_name_str(), (void *)get_handle<vhpiHandleT>());
         if (vhpi_release_handle(get_handle<vhpiHandleT>())) check_vhpi_error();
     }
 }
@@ -66,9 +81,11 @@ VhpiSignalObjHdl::~VhpiSignalObjHdl() {
 
     if (m_binvalue.value.str) delete[] m_binvalue.value.str;
 
-    LOG_DEBUG("VHPI: Releasing VhpiSignalObjHdl handle for %s at %p",
-              get_fullname_str(), (void *)get_handle<vhpiHandleT>());
-    if (vhpi_release_handle(get_handle<vhpiHandleT>())) check_vhpi_error();
+    if (!shares_handle()) {
+        LOG_DEBUG("VHPI: Releasing VhpiSignalObjHdl handle for %s at %p",
+                  get_name_str(), (void *)get_handle<vhpiHandleT>());
+        if (vhpi_release_handle(get_handle<vhpiHandleT>())) check_vhpi_error();
+    }
 }
 
 bool get_range(vhpiHandleT hdl, vhpiIntT dim, int *left, int *right,
@@ -261,10 +278,188 @@ int VhpiArrayObjHdl::initialise(const std::string &name,
     if (m_num_elems < 0) {
         m_num_elems = 0;
     }
+    m_one_dim = num_dim == 1;
 
     return GpiObjHdl::initialise(name, fq_name);
 }
 
+vhpiHandleT VhpiArrayObjHdl::element_handle(int index, vhpiFormatT *format) {
+    // Elements of multi-dimensional arrays are indexed in the flattened array
+    if (!m_one_dim || shares_handle()) {
+        return NULL;
+    }
+    int offset = m_range_dir == GPI_RANGE_DOWN ? m_range_left - index
+                                               : index - m_range_left;
+    vhpiHandleT elem = vhpi_handle_by_index(
+        vhpiIndexedNames, get_handle<vhpiHandleT>(), offset);
+    if (!elem || !format) {
+        return elem;
+    }
+
+    // Only elements of logic types have a binary string value, real elements
+    // are accessed as doubles
+    vhpiValueT value;
+    value.format = vhpiObjTypeVal;
+    value.bufSize = 0;
+    value.numElems = 0;
+    value.value.str = NULL;
+    if (vhpi_get_value(elem, &value) < 0 ||
+        (value.format != vhpiLogicVal && value.format != vhpiLogicVecVal &&
+         value.format != vhpiRealVal)) {
+        vhpi_release_handle(elem);
+        return NULL;
+    }
+    *format = value.format;
+    return elem;
+}
+
+int VhpiArrayObjHdl::get_element_width() {
+    vhpiFormatT format;
+    vhpiHandleT elem = element_handle(m_range_left, &format);
+    if (!elem) {
+        return GpiObjHdl::get_element_width();
+    }
+    int width = format == vhpiRealVal
+                    ? 64
+                    : static_cast<int>(vhpi_get(vhpiSizeP, elem));
+    vhpi_release_handle(elem);
+    return width > 0 ? width : -1;
+}
+
+// Real elements are only accessed as GPI_ARRAY_REAL and others only as bits
+static bool check_element_format(vhpiHandleT elem, vhpiFormatT elem_format,
+                                 gpi_array_format format, const char *name) {
+    if ((elem_format == vhpiRealVal) != (format == GPI_ARRAY_REAL)) {
+        LOG_ERROR("VHPI: Elements of %s can't be accessed in format %d", name,
+                  format);
+        vhpi_release_handle(elem);
+        return false;
+    }
+    return true;
+}
+
+int VhpiArrayObjHdl::read_elements(int first, int count,
+                                   gpi_array_format format, uint8_t *buffer) {
+    if (count == 0) {
+        return 0;
+    }
+    vhpiFormatT elem_format;
+    vhpiHandleT elem = element_handle(first, &elem_format);
+    if (!elem) {
+        return GpiObjHdl::read_elements(first, count, format, buffer);
+    }
+    if (!check_element_format(elem, elem_format, format, get_name_str())) {
+        vhpi_release_handle(elem);
+        return -1;
+    }
+    const int width = static_cast<int>(vhpi_get(vhpiSizeP, elem));
+    const size_t elem_size = gpi_array_element_size(width, format);
+
+    std::vector<vhpiCharT> binstr(static_cast<size_t>(width) + 1);
+    vhpiValueT value;
+    if (format == GPI_ARRAY_REAL) {
+        value.format = vhpiRealVal;
+        value.bufSize = 0;
+        value.numElems = 0;
+        value.value.real = 0.0;
+    } else {
+        value.format = vhpiBinStrVal;
+        value.bufSize = static_cast<bufSize_type>(binstr.size());
+        value.numElems = 0;
+        value.value.str = binstr.data();
+    }
+
+    for (int i = 0; i < count; i++) {
+        if (i) {
+            elem = element_handle(element_index(first, i), NULL);
+            if (!elem) {
+                LOG_ERROR("VHPI: Unable to read element %d of %s",
+                          element_index(first, i), get_name_str());
+                check_vhpi_error();
+                return -1;
+            }
+        }
+        if (vhpi_get_value(elem, &value)) {
+            check_vhpi_error();
+            vhpi_release_handle(elem);
+            return -1;
+        }
+        uint8_t *out = buffer + static_cast<size_t>(i) * elem_size;
+        if (format == GPI_ARRAY_REAL) {
+            memcpy(out, &value.value.real, sizeof(double));
+        } else {
+            gpi_binstr_to_element(binstr.data(), width, format, out);
+        }
+        vhpi_release_handle(elem);
+    }
+    return 0;
+}
+
+int VhpiArrayObjHdl::write_elements(int first, int count,
+                                    gpi_array_format format,
+                                    const uint8_t *buffer,
+                                    gpi_set_action action) {
+    if (count == 0) {
+        return 0;
+    }
+    vhpiFormatT elem_format;
+    vhpiHandleT elem = element_handle(first, &elem_format);
+    if (!elem) {
+        return GpiObjHdl::write_elements(first, count, format, buffer, action);
+    }
+    if (!check_element_format(elem, elem_format, format, get_name_str())) {
+        vhpi_release_handle(elem);
+        return -1;
+    }
+    const int width = static_cast<int>(vhpi_get(vhpiSizeP, elem));
+    const size_t elem_size = gpi_array_element_size(width, format);
+
+    std::vector<vhpiEnumT> enums;
+    vhpiValueT value;
+    value.format = elem_format;
+    if (elem_format == vhpiRealVal) {
+        value.bufSize = 0;
+        value.numElems = 0;
+    } else {
+        enums.resize(static_cast<size_t>(width));
+        value.bufSize =
+            static_cast<bufSize_type>(enums.size() * sizeof(vhpiEnumT));
+        value.numElems = width;
+        value.value.enumvs = enums.data();
+    }
+
+    for (int i = 0; i < count; i++) {
+        if (i) {
+            elem = element_handle(element_index(first, i), NULL);
+            if (!elem) {
+                LOG_ERROR("VHPI: Unable to write element %d of %s",
+                          element_index(first, i), get_name_str());
+                check_vhpi_error();
+                return -1;
+            }
+        }
+        const uint8_t *in = buffer + static_cast<size_t>(i) * elem_size;
+        if (elem_format == vhpiRealVal) {
+            memcpy(&value.value.real, in, sizeof(double));
+        } else if (elem_format == vhpiLogicVal) {
+            std::string binstr = gpi_element_to_binstr(in, width, format);
+            value.value.enumv = VhpiSignalObjHdl::chr2vhpi(binstr[0]);
+        } else {
+            std::string binstr = gpi_element_to_binstr(in, width, format);
+            for (size_t bit = 0; bit < enums.size(); bit++) {
+                enums[bit] = VhpiSignalObjHdl::chr2vhpi(binstr[bit]);
+            }
+        }
+        int ret = vhpi_put_value(elem, &value, map_put_value_mode(action));
+        vhpi_release_handle(elem);
+        if (ret) {
+            check_vhpi_error();
+            return -1;
+        }
+    }
+    return 0;
+}
+
 int VhpiObjHdl::initialise(const std::string &name,
                            const std::string &fq_name) {
     vhpiHandleT handle = GpiObjHdl::get_handle<vhpiHandleT>();
@@ -275,10 +470,10 @@ int VhpiObjHdl::initialise(const std::string &name,
             if (pu_handle != NULL) {
                 const char *str;
                 str = vhpi_get_str(vhpiNameP, pu_handle);
-                if (str != NULL) m_definition_name = str;
+                if (str != NULL) set_definition_name(str);
 
                 str = vhpi_get_str(vhpiFileNameP, pu_handle);
-                if (str != NULL) m_definition_file = str;
+                if (str != NULL) set_definition_file(str);
             }
         }
     }
@@ -474,7 +669,7 @@ int VhpiCbHdl::run() {
     // LCOV_EXCL_START
     if (!m_removed) {
         // Only call up if not removed.
-        res = m_cb_func(m_cb_data);
+        res = call_cb_func();
     }
     // LCOV_EXCL_STOP
 
@@ -615,6 +810,46 @@ int VhpiLogicSignalObjHdl::set_signal_value_binstr(std::string &value,
     return 0;
 }
 
+int VhpiLogicSignalObjHdl::set_signal_slice_binstr(int first,
+                                                   const std::string &value,
+                                                   gpi_set_action action) {
+    if (m_value.format != vhpiEnumVecVal &&
+        m_value.format != vhpiLogicVecVal) {
+        return GpiSignalObjHdl::set_signal_slice_binstr(first, value, action);
+    }
+
+    // Write each element through an indexed name, so that other writes to
+    // the vector in the same delta cycle aren't undone
+    vhpiValueT elem_value;
+    elem_value.format =
+        m_value.format == vhpiEnumVecVal ? vhpiEnumVal : vhpiLogicVal;
+    elem_value.bufSize = 0;
+    elem_value.numElems = 0;
+    for (size_t pos = 0; pos < value.size(); pos++) {
+        const int offset = first + static_cast<int>(pos);
+        vhpiHandleT elem = vhpi_handle_by_index(
+            vhpiIndexedNames, GpiObjHdl::get_handle<vhpiHandleT>(), offset);
+        if (!elem) {
+            if (pos == 0) {
+                return GpiSignalObjHdl::set_signal_slice_binstr(first, value,
+                                                                action);
+            }
+            LOG_ERROR("VHPI: Unable to write element %d of %s", offset,
+                      get_name_str());
+            check_vhpi_error();
+            return -1;
+        }
+        elem_value.value.enumv = chr2vhpi(value[pos]);
+        int ret = vhpi_put_value(elem, &elem_value, map_put_value_mode(action));
+        vhpi_release_handle(elem);
+        if (ret) {
+            check_vhpi_error();
+            return -1;
+        }
+    }
+    return 0;
+}
+
 // Value related functions
 int VhpiSignalObjHdl::set_signal_value(int32_t value, gpi_set_action action) {
     switch (m_value.format) {
@@ -894,14 +1129,14 @@ int VhpiValueCbHdl::run() {
             break;
         }
         case GPI_VALUE_CHANGE: {
-            pass = true;
+            pass = !m_filter.active() || m_filter.pass(m_signal);
             break;
         }
     }
 
     int res = 0;
     if (pass) {
-        res = m_cb_func(m_cb_data);
+        res = call_cb_func();
 
         // Remove recurring callback once fired
         auto err = vhpi_remove_cb(get_handle<vhpiHandleT>());
@@ -97,10 +97,12 @@ class VhpiValueCbHdl : public VhpiCbHdl {
     VhpiValueCbHdl(GpiImplInterface *impl, VhpiSignalObjHdl *sig,
                    gpi_edge edge);
     int run() override;
+    GpiValueFilter *get_value_filter() override { return &m_filter; }
 
   private:
     GpiSignalObjHdl *m_signal;
     gpi_edge m_edge;
+    GpiValueFilter m_filter;
 };
 
 class VhpiTimedCbHdl : public VhpiCbHdl {
@@ -128,7 +130,7 @@ class VhpiStartupCbHdl : public VhpiCbHdl {
     int run() override {
         int res = 0;
         if (!m_removed) {
-            res = m_cb_func(m_cb_data);
+            res = call_cb_func();
         }
         delete this;
         return res;
@@ -150,7 +152,7 @@ class VhpiShutdownCbHdl : public VhpiCbHdl {
     int run() override {
         int res = 0;
         if (!m_removed) {
-            res = m_cb_func(m_cb_data);
+            res = call_cb_func();
         }
         delete this;
         return res;
@@ -176,6 +178,18 @@ class VhpiArrayObjHdl : public GpiObjHdl {
 
     int initialise(const std::string &name,
                    const std::string &fq_name) override;
+
+    int get_element_width() override;
+    int read_elements(int first, int count, gpi_array_format format,
+                      uint8_t *buffer) override;
+    int write_elements(int first, int count, gpi_array_format format,
+                       const uint8_t *buffer, gpi_set_action action) override;
+
+  private:
+    // Handle of an element, or NULL if it can't be accessed directly
+    vhpiHandleT element_handle(int index, vhpiFormatT *format);
+
+    bool m_one_dim = false;
 };
 
 class VhpiObjHdl : public GpiObjHdl {
@@ -215,8 +229,9 @@ class VhpiSignalObjHdl : public GpiSignalObjHdl {
                                              int (*function)(void *),
                                              void *cb_data) override;
 
+    static vhpiEnumT chr2vhpi(char value);
+
   protected:
-    vhpiEnumT chr2vhpi(char value);
     vhpiValueT m_value;
     vhpiValueT m_binvalue;
 };
@@ -231,6 +246,8 @@ class VhpiLogicSignalObjHdl : public VhpiSignalObjHdl {
     int set_signal_value(int32_t value, gpi_set_action action) override;
     int set_signal_value_binstr(std::string &value,
                                 gpi_set_action action) override;
+    int set_signal_slice_binstr(int first, const std::string &value,
+                                gpi_set_action action) override;
 
     int initialise(const std::string &name,
                    const std::string &fq_name) override;
@@ -5,7 +5,9 @@
 // SPDX-License-Identifier: BSD-3-Clause
 
 #include "VpiImpl.h"
+#include "cocotb_utils.h"
 #include "gpi_logging.h"
+#include "gpi_probes.h"
 #include "share/lib/gpi/gpi_priv.h"
 
 #ifndef VPI_NO_QUEUE_SETIMMEDIATE_CALLBACKS
@@ -36,10 +38,21 @@ static int32_t handle_vpi_callback_(GpiCbHdl *cb_hdl) {
     return 0;
 }
 
+static inline uint64_t cb_sim_time(p_cb_data cb_data) {
+    if (cb_data->time && cb_data->time->type == vpiSimTime) {
+        return ((uint64_t)cb_data->time->high << 32) | cb_data->time->low;
+    }
+    return 0;
+}
+
 // Main re-entry point for callbacks from simulator
 int32_t handle_vpi_callback(p_cb_data cb_data) {
-#ifdef VPI_NO_QUEUE_SETIMMEDIATE_CALLBACKS
+    // cb_data may not outlive the callback, so copy what the probes need
+    PLI_INT32 reason = cb_data->reason;
     VpiCbHdl *cb_hdl = (VpiCbHdl *)cb_data->user_data;
+    GPI_PROBE3(vpi_callback, reason, cb_hdl, cb_sim_time(cb_data));
+    DEFER(GPI_PROBE2(vpi_callback_return, reason, cb_hdl));
+#ifdef VPI_NO_QUEUE_SETIMMEDIATE_CALLBACKS
     return handle_vpi_callback_(cb_hdl);
 #else
     // must push things into a queue because Icaurus (gh-4067), Xcelium
@@ -47,7 +60,6 @@ int32_t handle_vpi_callback(p_cb_data cb_data) {
     // are set with vpiNoDelay immediately, and not after the current callback
     // has ended, causing re-entrancy.
     static bool reacting = false;
-    VpiCbHdl *cb_hdl = (VpiCbHdl *)cb_data->user_data;
     if (reacting) {
         cb_queue.push_back(cb_hdl);
         return 0;
@@ -131,7 +143,7 @@ int VpiCbHdl::run() {
     // LCOV_EXCL_START
     if (!m_removed) {
         // Only call up if not removed.
-        res = m_cb_func(m_cb_data);
+        res = call_cb_func();
     }
     // LCOV_EXCL_STOP
 
@@ -188,14 +200,14 @@ int VpiValueCbHdl::run() {
             break;
         }
         case GPI_VALUE_CHANGE: {
-            pass = true;
+            pass = !m_filter.active() || m_filter.pass(m_signal);
             break;
         }
     }
 
     int res = 0;
     if (pass) {
-        res = m_cb_func(m_cb_data);
+        res = call_cb_func();
 
         // Remove recurring callback once fired.
         auto err = vpi_remove_cb(get_handle<vpiHandle>());
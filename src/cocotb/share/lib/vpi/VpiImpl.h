@@ -90,11 +90,13 @@ class VpiValueCbHdl : public VpiCbHdl {
   public:
     VpiValueCbHdl(GpiImplInterface *impl, VpiSignalObjHdl *sig, gpi_edge edge);
     int run() override;
+    GpiValueFilter *get_value_filter() override { return &m_filter; }
 
   private:
     s_vpi_value m_vpi_value;
     GpiSignalObjHdl *m_signal;
     gpi_edge m_edge;
+    GpiValueFilter m_filter;
 };
 
 class VpiTimedCbHdl : public VpiCbHdl {
@@ -127,7 +129,7 @@ class VpiStartupCbHdl : public VpiCbHdl {
     int run() override {
         int res = 0;
         if (!m_removed) {
-            res = m_cb_func(m_cb_data);
+            res = call_cb_func();
         }
         delete this;
         return res;
@@ -149,7 +151,7 @@ class VpiShutdownCbHdl : public VpiCbHdl {
     int run() override {
         int res = 0;
         if (!m_removed) {
-            res = m_cb_func(m_cb_data);
+            res = call_cb_func();
         }
         delete this;
         return res;
@@ -165,15 +167,27 @@ class VpiArrayObjHdl : public GpiObjHdl {
   public:
     VpiArrayObjHdl(GpiImplInterface *impl, vpiHandle hdl, gpi_objtype objtype)
         : GpiObjHdl(impl, hdl, objtype) {}
+    ~VpiArrayObjHdl() override;
 
     int initialise(const std::string &name,
                    const std::string &fq_name) override;
+
+    int get_element_width() override;
+    int read_elements(int first, int count, gpi_array_format format,
+                      uint8_t *buffer) override;
+    int write_elements(int first, int count, gpi_array_format format,
+                       const uint8_t *buffer, gpi_set_action action) override;
+
+  private:
+    // Handle of an element, or NULL if it can't be accessed directly
+    vpiHandle element_handle(int index);
 };
 
 class VpiObjHdl : public GpiObjHdl {
   public:
     VpiObjHdl(GpiImplInterface *impl, vpiHandle hdl, gpi_objtype objtype)
         : GpiObjHdl(impl, hdl, objtype) {}
+    ~VpiObjHdl() override;
 
     const char *get_definition_name() override;
     const char *get_definition_file() override;
@@ -184,6 +198,7 @@ class VpiSignalObjHdl : public GpiSignalObjHdl {
     VpiSignalObjHdl(GpiImplInterface *impl, vpiHandle hdl, gpi_objtype objtype,
                     bool is_const)
         : GpiSignalObjHdl(impl, hdl, objtype, is_const) {}
+    ~VpiSignalObjHdl() override;
 
     const char *get_signal_value_binstr() override;
     const char *get_signal_value_str() override;
@@ -196,6 +211,8 @@ class VpiSignalObjHdl : public GpiSignalObjHdl {
                                 gpi_set_action action) override;
     int set_signal_value_str(std::string &value,
                              gpi_set_action action) override;
+    int set_signal_slice_binstr(int first, const std::string &value,
+                                gpi_set_action action) override;
 
     /* Value change callback accessor */
     int initialise(const std::string &name,
@@ -206,8 +223,70 @@ class VpiSignalObjHdl : public GpiSignalObjHdl {
 
   private:
     int set_signal_value(s_vpi_value value, gpi_set_action action);
+
+#ifdef VERILATOR
+    // Verilator model storage of this signal, if it could be resolved.
+    // Accessing it directly avoids the value formatting and lookups done by
+    // Verilator's VPI emulation.
+    void *m_direct_data = nullptr;
+    int m_direct_bytes = 0;  // 1, 2, 4, 8, or 0 for wide (32-bit words)
+    // Variables without public_flat_rw are still written through VPI, which
+    // reports the write as an error.
+    bool m_direct_writable = false;
+
+    bool direct_access() const { return m_direct_data != nullptr; }
+    bool direct_write_access(gpi_set_action action) const {
+        return m_direct_writable &&
+               (action == GPI_DEPOSIT || action == GPI_NO_DELAY);
+    }
+    int direct_num_words() const { return (m_num_elems + 31) / 32; }
+    uint32_t direct_get_word(int idx) const;
+    // Returns buffers for the words (and the mask of bits) to write, cleared
+    // to the size of the signal. They are reused by every direct write.
+    std::vector<uint32_t> &direct_words();
+    std::vector<uint32_t> &direct_mask();
+    void direct_write(gpi_set_action action, bool masked = false);
+#endif
 };
 
+#ifdef VERILATOR
+extern "C" {
+/** Resolve the full VPI name of a Verilator variable to its storage.
+ *
+ * Implemented by the Verilator harness, which can see the model's symbol
+ * table. Returns `false` if the variable can't be accessed directly.
+ * *container_bytes* is set to the size of the variable's C type (1, 2, 4 or
+ * 8), or to 0 for wide variables stored as arrays of 32-bit words.
+ * *writable* is set if the variable may be written, i.e. it is
+ * public_flat_rw.
+ */
+typedef bool (*vpi_verilator_var_resolver)(const char *fullname, void **datap,
+                                           int *container_bytes,
+                                           bool *writable);
+
+/** Enable direct access to Verilator model storage for signal handles.
+ *
+ * *eval_needed* is called whenever a direct write changes the model, as
+ * Verilator can't see those writes itself.
+ */
+COCOTBVPI_EXPORT void vpi_verilator_set_direct_access(
+    vpi_verilator_var_resolver resolver, void (*eval_needed)(void));
+
+/** Apply deposits staged through direct access.
+ *
+ * Must be called alongside `VerilatedVpi::doInertialPuts()`.
+ */
+COCOTBVPI_EXPORT void vpi_verilator_do_direct_puts(void);
+
+/** Check whether cocotb has written any signal since the last call.
+ *
+ * Lets the harness skip evaluating the model in time steps where nothing
+ * changed.
+ */
+COCOTBVPI_EXPORT bool vpi_verilator_take_writes(void);
+}
+#endif
+
 class VpiIterator : public GpiIterator {
   public:
     VpiIterator(GpiImplInterface *impl, GpiObjHdl *hdl);
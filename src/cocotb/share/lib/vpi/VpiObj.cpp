@@ -8,6 +8,12 @@
 
 #include "VpiImpl.h"
 
+VpiArrayObjHdl::~VpiArrayObjHdl() {
+    if (!shares_handle()) {
+        vpi_free_object(get_handle<vpiHandle>());
+    }
+}
+
 int VpiArrayObjHdl::initialise(const std::string &name,
                                const std::string &fq_name) {
     vpiHandle hdl = GpiObjHdl::get_handle<vpiHandle>();
@@ -92,24 +98,30 @@ int VpiArrayObjHdl::initialise(const std::string &name,
     return GpiObjHdl::initialise(name, fq_name);
 }
 
+VpiObjHdl::~VpiObjHdl() {
+    if (!shares_handle()) {
+        vpi_free_object(get_handle<vpiHandle>());
+    }
+}
+
 const char *VpiObjHdl::get_definition_name() {
-    if (m_definition_name.empty()) {
+    if (!has_definition_name()) {
         auto hdl = get_handle<vpiHandle>();
         auto *str = vpi_get_str(vpiDefName, hdl);
         if (str != NULL) {
-            m_definition_name = str;
+            set_definition_name(str);
         }
     }
-    return m_definition_name.c_str();
+    return GpiObjHdl::get_definition_name();
 }
 
 const char *VpiObjHdl::get_definition_file() {
-    if (m_definition_file.empty()) {
+    if (!has_definition_file()) {
         auto hdl = GpiObjHdl::get_handle<vpiHandle>();
         auto *str = vpi_get_str(vpiDefFile, hdl);
         if (str != NULL) {
-            m_definition_file = str;
+            set_definition_file(str);
         }
     }
-    return m_definition_file.c_str();
+    return GpiObjHdl::get_definition_file();
 }
@@ -4,12 +4,152 @@
 // Licensed under the Revised BSD License, see LICENSE for details.
 // SPDX-License-Identifier: BSD-3-Clause
 
+#include <algorithm>  // std::copy
 #include <cassert>
+#include <cstdint>  // uint32_t, INT32_MAX
+#include <cstring>  // memcpy
 
 #include "VpiImpl.h"
 #include "gpi.h"
 #include "vpi_user_ext.h"
 
+#ifdef VERILATOR
+static vpi_verilator_var_resolver direct_resolver = nullptr;
+static void (*direct_eval_needed)(void) = nullptr;
+
+struct DirectPut {
+    void *data;
+    int bytes;
+    std::vector<uint32_t> words;
+    std::vector<uint32_t> mask;  // Bits to write, empty for all of them
+};
+
+// Set by every write, through VPI or directly
+static bool writes_since_check = false;
+
+// Deposits are inertial, so like Verilator's own inertial puts they are
+// staged until the harness applies them between evaluations. Applied puts
+// are kept so that their buffers are reused by later deposits.
+static std::vector<DirectPut> direct_puts;
+static size_t num_direct_puts = 0;
+
+// Scratch buffers for building the value of a direct write
+static std::vector<uint32_t> direct_words_buf;
+static std::vector<uint32_t> direct_mask_buf;
+
+static uint32_t direct_load(const void *data, int bytes, int idx) {
+    switch (bytes) {
+        case 1:
+            return *static_cast<const uint8_t *>(data);
+        case 2:
+            return *static_cast<const uint16_t *>(data);
+        case 4:
+            return *static_cast<const uint32_t *>(data);
+        case 8:
+            return static_cast<uint32_t>(*static_cast<const uint64_t *>(data) >>
+                                         (32 * idx));
+        default:
+            return static_cast<const uint32_t *>(data)[idx];
+    }
+}
+
+static void direct_store(void *data, int bytes, std::vector<uint32_t> &words,
+                         const std::vector<uint32_t> &mask) {
+    // Merge slices with the current value when they are applied, so that
+    // several staged slices of a signal all take effect
+    for (size_t idx = 0; idx < mask.size(); idx++) {
+        words[idx] =
+            (direct_load(data, bytes, static_cast<int>(idx)) & ~mask[idx]) |
+            (words[idx] & mask[idx]);
+    }
+    switch (bytes) {
+        case 1:
+            *static_cast<uint8_t *>(data) = static_cast<uint8_t>(words[0]);
+            break;
+        case 2:
+            *static_cast<uint16_t *>(data) = static_cast<uint16_t>(words[0]);
+            break;
+        case 4:
+            *static_cast<uint32_t *>(data) = words[0];
+            break;
+        case 8:
+            *static_cast<uint64_t *>(data) =
+                (static_cast<uint64_t>(words.size() > 1 ? words[1] : 0)
+                 << 32) |
+                words[0];
+            break;
+        default:
+            std::copy(words.begin(), words.end(),
+                      static_cast<uint32_t *>(data));
+    }
+}
+
+extern "C" void vpi_verilator_set_direct_access(
+    vpi_verilator_var_resolver resolver, void (*eval_needed)(void)) {
+    direct_resolver = resolver;
+    direct_eval_needed = eval_needed;
+}
+
+extern "C" bool vpi_verilator_take_writes(void) {
+    bool writes = writes_since_check;
+    writes_since_check = false;
+    return writes;
+}
+
+extern "C" void vpi_verilator_do_direct_puts(void) {
+    if (num_direct_puts == 0) {
+        return;
+    }
+    for (size_t idx = 0; idx < num_direct_puts; idx++) {
+        auto &put = direct_puts[idx];
+        direct_store(put.data, put.bytes, put.words, put.mask);
+    }
+    num_direct_puts = 0;
+    direct_eval_needed();
+}
+
+uint32_t VpiSignalObjHdl::direct_get_word(int idx) const {
+    return direct_load(m_direct_data, m_direct_bytes, idx);
+}
+
+std::vector<uint32_t> &VpiSignalObjHdl::direct_words() {
+    direct_words_buf.assign(static_cast<size_t>(direct_num_words()), 0);
+    return direct_words_buf;
+}
+
+std::vector<uint32_t> &VpiSignalObjHdl::direct_mask() {
+    direct_mask_buf.assign(static_cast<size_t>(direct_num_words()), 0);
+    return direct_mask_buf;
+}
+
+void VpiSignalObjHdl::direct_write(gpi_set_action action, bool masked) {
+    if (!masked) {
+        direct_mask_buf.clear();
+    }
+    writes_since_check = true;
+    if (action == GPI_DEPOSIT) {
+        if (num_direct_puts == direct_puts.size()) {
+            direct_puts.emplace_back();
+        }
+        auto &put = direct_puts[num_direct_puts++];
+        put.data = m_direct_data;
+        put.bytes = m_direct_bytes;
+        put.words.assign(direct_words_buf.begin(), direct_words_buf.end());
+        put.mask.assign(direct_mask_buf.begin(), direct_mask_buf.end());
+    } else {
+        direct_store(m_direct_data, m_direct_bytes, direct_words_buf,
+                     direct_mask_buf);
+        direct_eval_needed();
+    }
+}
+#endif
+
+VpiSignalObjHdl::~VpiSignalObjHdl() {
+    if (!shares_handle()) {
+        vpi_free_object(get_handle<vpiHandle>());
+    }
+}
+
 int VpiSignalObjHdl::initialise(const std::string &name,
                                 const std::string &fq_name) {
     int32_t type = vpi_get(vpiType, GpiObjHdl::get_handle<vpiHandle>());
@@ -92,10 +232,52 @@ int VpiSignalObjHdl::initialise(const std::string &name,
     m_range_dir = m_range_left > m_range_right ? GPI_RANGE_DOWN : GPI_RANGE_UP;
     LOG_DEBUG("VPI: %s initialized with %d elements", name.c_str(),
               m_num_elems);
+
+#ifdef VERILATOR
+    if (direct_resolver && (GpiObjHdl::get_type() == GPI_LOGIC ||
+                            GpiObjHdl::get_type() == GPI_LOGIC_ARRAY)) {
+        vpiHandle hdl = GpiObjHdl::get_handle<vpiHandle>();
+        const char *vpi_fullname = vpi_get_str(vpiFullName, hdl);
+        void *data = nullptr;
+        int bytes = 0;
+        bool writable = false;
+        if (vpi_fullname &&
+            direct_resolver(vpi_fullname, &data, &bytes, &writable)) {
+            // Only use the storage if it has the shape VPI reported
+            const int container_bits = bytes ? bytes * 8 : INT32_MAX;
+            const bool is_wide = m_num_elems > 64;
+            if (m_num_elems > 0 && m_num_elems <= container_bits &&
+                is_wide == (bytes == 0)) {
+                m_direct_data = data;
+                m_direct_bytes = bytes;
+                m_direct_writable = writable;
+                LOG_DEBUG("VPI: Using direct access for %s", name.c_str());
+            }
+        }
+    }
+#endif
+
     return GpiObjHdl::initialise(name, fq_name);
 }
 
 const char *VpiSignalObjHdl::get_signal_value_binstr() {
+#ifdef VERILATOR
+    if (direct_access()) {
+        static std::vector<char> binstr;
+        binstr.resize(static_cast<size_t>(m_num_elems) + 1);
+        uint32_t word = 0;
+        for (int bit = 0; bit < m_num_elems; bit++) {
+            if (bit % 32 == 0) {
+                word = direct_get_word(bit / 32);
+            }
+            binstr[static_cast<size_t>(m_num_elems - 1 - bit)] =
+                (word >> (bit % 32)) & 1 ? '1' : '0';
+        }
+        binstr[static_cast<size_t>(m_num_elems)] = '\0';
+        return binstr.data();
+    }
+#endif
+
     s_vpi_value value_s = {vpiBinStrVal, {NULL}};
 
     vpi_get_value(GpiObjHdl::get_handle<vpiHandle>(), &value_s);
@@ -123,6 +305,13 @@ double VpiSignalObjHdl::get_signal_value_real() {
 }
 
 long VpiSignalObjHdl::get_signal_value_long() {
+#ifdef VERILATOR
+    if (direct_access()) {
+        // Same as vpiIntVal: the low 32 bits
+        return static_cast<int32_t>(direct_get_word(0));
+    }
+#endif
+
     s_vpi_value value_s = {vpiIntVal, {NULL}};
 
     vpi_get_value(GpiObjHdl::get_handle<vpiHandle>(), &value_s);
@@ -133,6 +322,18 @@ long VpiSignalObjHdl::get_signal_value_long() {
 
 // Value related functions
 int VpiSignalObjHdl::set_signal_value(int32_t value, gpi_set_action action) {
+#ifdef VERILATOR
+    if (direct_write_access(action)) {
+        auto &words = direct_words();
+        words[0] = static_cast<uint32_t>(value);
+        if (m_num_elems < 32) {
+            words[0] &= (1u << m_num_elems) - 1;
+        }
+        direct_write(action);
+        return 0;
+    }
+#endif
+
     s_vpi_value value_s;
 
     value_s.value.integer = static_cast<PLI_INT32>(value);
@@ -152,6 +353,22 @@ int VpiSignalObjHdl::set_signal_value(double value, gpi_set_action action) {
 
 int VpiSignalObjHdl::set_signal_value_binstr(std::string &value,
                                              gpi_set_action action) {
+#ifdef VERILATOR
+    if (direct_write_access(action)) {
+        // Verilator models are 2-state, so anything but '1' is a 0, as in
+        // Verilator's own vpiBinStrVal handling.
+        auto &words = direct_words();
+        const int len = static_cast<int>(value.size());
+        for (int bit = 0; bit < m_num_elems && bit < len; bit++) {
+            if (value[static_cast<size_t>(len - 1 - bit)] == '1') {
+                words[static_cast<size_t>(bit / 32)] |= 1u << (bit % 32);
+            }
+        }
+        direct_write(action);
+        return 0;
+    }
+#endif
+
     s_vpi_value value_s;
 
     std::vector<char> writable(value.begin(), value.end());
@@ -176,8 +393,9 @@ int VpiSignalObjHdl::set_signal_value_str(std::string &value,
     return set_signal_value(value_s, action);
 }
 
-int VpiSignalObjHdl::set_signal_value(s_vpi_value value_s,
-                                      gpi_set_action action) {
+// Shared by signals and bulk writes to the elements of arrays
+static void put_value(vpiHandle hdl, s_vpi_value &value_s,
+                      gpi_set_action action) {
     PLI_INT32 vpi_put_flag = -1;
     s_vpi_time vpi_time_s;
 
@@ -190,8 +408,7 @@ int VpiSignalObjHdl::set_signal_value(s_vpi_value value_s,
 #if defined(MODELSIM) || defined(IUS)
             // Xcelium and Questa do not like setting string variables using
             // vpiInertialDelay.
-            if (vpiStringVar ==
-                vpi_get(vpiType, GpiObjHdl::get_handle<vpiHandle>())) {
+            if (vpiStringVar == vpi_get(vpiType, hdl)) {
                 vpi_put_flag = vpiNoDelay;
             } else {
                 vpi_put_flag = vpiInertialDelay;
@@ -205,7 +422,7 @@ int VpiSignalObjHdl::set_signal_value(s_vpi_value value_s,
             break;
         case GPI_RELEASE:
             // Best to pass its current value to the sim when releasing
-            vpi_get_value(GpiObjHdl::get_handle<vpiHandle>(), &value_s);
+            vpi_get_value(hdl, &value_s);
             vpi_put_flag = vpiReleaseFlag;
             break;
         case GPI_NO_DELAY:
@@ -215,16 +432,84 @@ int VpiSignalObjHdl::set_signal_value(s_vpi_value value_s,
             assert(0);
     }
 
+#ifdef VERILATOR
+    writes_since_check = true;
+#endif
     if (vpi_put_flag == vpiNoDelay) {
-        vpi_put_value(GpiObjHdl::get_handle<vpiHandle>(), &value_s, NULL,
-                      vpiNoDelay);
+        vpi_put_value(hdl, &value_s, NULL, vpiNoDelay);
     } else {
-        vpi_put_value(GpiObjHdl::get_handle<vpiHandle>(), &value_s, &vpi_time_s,
-                      vpi_put_flag);
+        vpi_put_value(hdl, &value_s, &vpi_time_s, vpi_put_flag);
     }
 
     check_vpi_error();
+}
+
+int VpiSignalObjHdl::set_signal_value(s_vpi_value value_s,
+                                      gpi_set_action action) {
+    put_value(GpiObjHdl::get_handle<vpiHandle>(), value_s, action);
+    return 0;
+}
+
+int VpiSignalObjHdl::set_signal_slice_binstr(int first,
+                                             const std::string &value,
+                                             gpi_set_action action) {
+    const int count = static_cast<int>(value.size());
+#ifdef VERILATOR
+    if (direct_write_access(action)) {
+        auto &words = direct_words();
+        auto &mask = direct_mask();
+        for (int pos = 0; pos < count; pos++) {
+            const int bit = m_num_elems - 1 - (first + pos);
+            const uint32_t bit_mask = 1u << (bit % 32);
+            mask[static_cast<size_t>(bit / 32)] |= bit_mask;
+            if (value[static_cast<size_t>(pos)] == '1') {
+                words[static_cast<size_t>(bit / 32)] |= bit_mask;
+            }
+        }
+        direct_write(action, true);
+        return 0;
+    }
+#endif
 
+    // Write each bit through a bit-select, so that other writes to the vector
+    // in the same time step aren't undone
+    for (int pos = 0; pos < count; pos++) {
+        const int index = element_index(m_range_left, first + pos);
+        vpiHandle bit =
+            vpi_handle_by_index(GpiObjHdl::get_handle<vpiHandle>(), index);
+        if (!bit) {
+            if (pos == 0) {
+                return GpiSignalObjHdl::set_signal_slice_binstr(first, value,
+                                                                action);
+            }
+            LOG_ERROR("VPI: Unable to write bit %d of %s", index,
+                      get_name_str());
+            check_vpi_error();
+            return -1;
+        }
+        s_vpi_value value_s;
+        value_s.format = vpiScalarVal;
+        switch (value[static_cast<size_t>(pos)]) {
+            case '0':
+            case 'L':
+            case 'l':
+                value_s.value.scalar = vpi0;
+                break;
+            case '1':
+            case 'H':
+            case 'h':
+                value_s.value.scalar = vpi1;
+                break;
+            case 'Z':
+            case 'z':
+                value_s.value.scalar = vpiZ;
+                break;
+            default:
+                value_s.value.scalar = vpiX;
+        }
+        put_value(bit, value_s, action);
+        vpi_free_object(bit);
+    }
     return 0;
 }
 
@@ -238,3 +523,183 @@ GpiCbHdl *VpiSignalObjHdl::register_value_change_callback(
     cb_hdl->set_cb_info(cb_func, cb_data);
     return cb_hdl;
 }
+
+vpiHandle VpiArrayObjHdl::element_handle(int index) {
+    // Pseudo-handles of multi-dimensional arrays are indexed by name
+    if (shares_handle()) {
+        return NULL;
+    }
+    vpiHandle elem = vpi_handle_by_index(get_handle<vpiHandle>(), index);
+    if (!elem) {
+        return NULL;
+    }
+    switch (vpi_get(vpiType, elem)) {
+        case vpiNet:
+        case vpiNetBit:
+        case vpiBitVar:
+        case vpiReg:
+        case vpiRegBit:
+        case vpiMemoryWord:
+        case vpiPackedArrayVar:
+        case vpiPackedArrayNet:
+        case vpiIntVar:
+        case vpiIntegerVar:
+        case vpiIntegerNet:
+        case vpiRealVar:
+        case vpiRealNet:
+            return elem;
+        default:
+            vpi_free_object(elem);
+            return NULL;
+    }
+}
+
+static bool is_real(vpiHandle elem) {
+    const PLI_INT32 type = vpi_get(vpiType, elem);
+    return type == vpiRealVar || type == vpiRealNet;
+}
+
+// Real elements are only accessed as GPI_ARRAY_REAL and others only as bits
+static bool check_element_format(vpiHandle elem, gpi_array_format format,
+                                 const char *name) {
+    if (is_real(elem) != (format == GPI_ARRAY_REAL)) {
+        LOG_ERROR("VPI: Elements of %s can't be accessed in format %d", name,
+                  format);
+        vpi_free_object(elem);
+        return false;
+    }
+    return true;
+}
+
+int VpiArrayObjHdl::get_element_width() {
+    vpiHandle elem = element_handle(m_range_left);
+    if (!elem) {
+        return GpiObjHdl::get_element_width();
+    }
+    int width = is_real(elem) ? 64 : vpi_get(vpiSize, elem);
+    vpi_free_object(elem);
+    return width > 0 ? width : -1;
+}
+
+int VpiArrayObjHdl::read_elements(int first, int count,
+                                  gpi_array_format format, uint8_t *buffer) {
+    if (count == 0) {
+        return 0;
+    }
+    vpiHandle elem = element_handle(first);
+    if (!elem) {
+        return GpiObjHdl::read_elements(first, count, format, buffer);
+    }
+    if (!check_element_format(elem, format, get_name_str())) {
+        vpi_free_object(elem);
+        return -1;
+    }
+    const int width = vpi_get(vpiSize, elem);
+    const size_t elem_size = gpi_array_element_size(width, format);
+
+    s_vpi_value value_s;
+    switch (format) {
+        case GPI_ARRAY_UINT:
+            value_s.format = vpiVectorVal;
+            break;
+        case GPI_ARRAY_REAL:
+            value_s.format = vpiRealVal;
+            break;
+        default:
+            value_s.format = vpiBinStrVal;
+    }
+
+    for (int i = 0; i < count; i++) {
+        if (i) {
+            elem = vpi_handle_by_index(get_handle<vpiHandle>(),
+                                       element_index(first, i));
+            if (!elem) {
+                LOG_ERROR("VPI: Unable to read element %d of %s",
+                          element_index(first, i), get_name_str());
+                check_vpi_error();
+                return -1;
+            }
+        }
+        uint8_t *out = buffer + static_cast<size_t>(i) * elem_size;
+        vpi_get_value(elem, &value_s);
+        check_vpi_error();
+        if (format == GPI_ARRAY_UINT) {
+            // X and Z bits have bval set
+            for (size_t byte = 0; byte < elem_size; byte++) {
+                const s_vpi_vecval &vec = value_s.value.vector[byte / 4];
+                const uint32_t known = static_cast<uint32_t>(vec.aval) &
+                                       ~static_cast<uint32_t>(vec.bval);
+                out[byte] = static_cast<uint8_t>(known >> (8 * (byte % 4)));
+            }
+            if (width % 8) {
+                out[elem_size - 1] &=
+                    static_cast<uint8_t>((1u << (width % 8)) - 1);
+            }
+        } else if (format == GPI_ARRAY_REAL) {
+            memcpy(out, &value_s.value.real, sizeof(double));
+        } else {
+            gpi_binstr_to_element(value_s.value.str, width, format, out);
+        }
+        vpi_free_object(elem);
+    }
+    return 0;
+}
+
+int VpiArrayObjHdl::write_elements(int first, int count,
+                                   gpi_array_format format,
+                                   const uint8_t *buffer,
+                                   gpi_set_action action) {
+    if (count == 0) {
+        return 0;
+    }
+    vpiHandle elem = element_handle(first);
+    if (!elem) {
+        return GpiObjHdl::write_elements(first, count, format, buffer, action);
+    }
+    if (!check_element_format(elem, format, get_name_str())) {
+        vpi_free_object(elem);
+        return -1;
+    }
+    const int width = vpi_get(vpiSize, elem);
+    const size_t elem_size = gpi_array_element_size(width, format);
+
+    std::vector<s_vpi_vecval> vector(static_cast<size_t>((width + 31) / 32));
+    std::string binstr;
+
+    for (int i = 0; i < count; i++) {
+        if (i) {
+            elem = vpi_handle_by_index(get_handle<vpiHandle>(),
+                                       element_index(first, i));
+            if (!elem) {
+                LOG_ERROR("VPI: Unable to write element %d of %s",
+                          element_index(first, i), get_name_str());
+                check_vpi_error();
+                return -1;
+            }
+        }
+        const uint8_t *in = buffer + static_cast<size_t>(i) * elem_size;
+        s_vpi_value value_s;
+        if (format == GPI_ARRAY_UINT) {
+            for (auto &vec : vector) {
+                vec.aval = 0;
+                vec.bval = 0;
+            }
+            for (size_t byte = 0; byte < elem_size; byte++) {
+                vector[byte / 4].aval |= static_cast<PLI_INT32>(
+                    static_cast<uint32_t>(in[byte]) << (8 * (byte % 4)));
+            }
+            value_s.format = vpiVectorVal;
+            value_s.value.vector = vector.data();
+        } else if (format == GPI_ARRAY_REAL) {
+            value_s.format = vpiRealVal;
+            memcpy(&value_s.value.real, in, sizeof(double));
+        } else {
+            binstr = gpi_element_to_binstr(in, width, format);
+            value_s.format = vpiBinStrVal;
+            value_s.value.str = &binstr[0];
+        }
+        put_value(elem, value_s, action);
+        vpi_free_object(elem);
+    }
+    return 0;
+}
@@ -5,7 +5,7 @@
 # generated with mypy's stubgen script
 
 from logging import Logger
-from typing import Any, Callable
+from typing import Any, Callable, Sequence
 
 from cocotb.handle import GPIDiscovery
 
@@ -32,6 +32,12 @@ VALUE_CHANGE: int
 RANGE_UP: int
 RANGE_DOWN: int
 RANGE_NO_DIR: int
+ARRAY_BINSTR: int
+ARRAY_UINT: int
+ARRAY_REAL: int
+MEM_BIN: int
+MEM_HEX: int
+MEM_ELF: int
 
 class gpi_cb_hdl:
     def deregister(self) -> None: ...
@@ -39,6 +45,16 @@ class gpi_cb_hdl:
     def __ne__(self, other: object) -> bool: ...
     def __hash__(self) -> int: ...
 
+class gpi_cb_group:
+    def add(self, signal: gpi_sim_hdl, /) -> int: ...
+    def remove(self, member: int, /) -> None: ...
+    def arm(self, func: Callable[..., Any], /, *args: Any) -> None: ...
+    def disarm(self) -> None: ...
+    def changed(self) -> list[int]: ...
+    def __eq__(self, other: object) -> bool: ...
+    def __ne__(self, other: object) -> bool: ...
+    def __hash__(self) -> int: ...
+
 class gpi_iterator_hdl:
     def __eq__(self, other: object) -> bool: ...
     def __ne__(self, other: object) -> bool: ...
@@ -46,7 +62,28 @@ class gpi_iterator_hdl:
     def __iter__(self) -> gpi_iterator_hdl: ...
     def __next__(self) -> gpi_sim_hdl: ...
 
+class gpi_object_info(tuple[Any, ...]):
+    @property
+    def type(self) -> int: ...
+    @property
+    def type_string(self) -> str: ...
+    @property
+    def name(self) -> str: ...
+    @property
+    def const(self) -> bool: ...
+    @property
+    def indexable(self) -> bool: ...
+    @property
+    def num_elems(self) -> int: ...
+    @property
+    def range(self) -> tuple[int, int, int]: ...
+    @property
+    def definition_name(self) -> str: ...
+    @property
+    def definition_file(self) -> str: ...
+
 class gpi_sim_hdl:
+    def get_array_element_width(self) -> int: ...
     def get_const(self) -> bool: ...
     def get_definition_file(self) -> str: ...
     def get_definition_name(self) -> str: ...
@@ -55,9 +92,11 @@ class gpi_sim_hdl:
         self, name: str, discovery_method: GPIDiscovery | None = GPIDiscovery.AUTO
     ) -> gpi_sim_hdl | None: ...
     def get_indexable(self) -> bool: ...
+    def get_info(self) -> gpi_object_info: ...
     def get_name_string(self) -> str: ...
     def get_num_elems(self) -> int: ...
     def get_range(self) -> tuple[int, int, int]: ...
+    def get_signal_slice(self, left: int, right: int) -> str: ...
     def get_signal_val_binstr(self) -> str: ...
     def get_signal_val_long(self) -> int: ...
     def get_signal_val_real(self) -> float: ...
@@ -65,10 +104,17 @@ class gpi_sim_hdl:
     def get_type(self) -> int: ...
     def get_type_string(self) -> str: ...
     def iterate(self, mode: int) -> gpi_iterator_hdl: ...
+    def read_array(self, first: int, count: int, format: int, buffer: Any) -> None: ...
+    def set_signal_slice(
+        self, action: int, left: int, right: int, value: str
+    ) -> None: ...
     def set_signal_val_binstr(self, action: int, value: str) -> None: ...
     def set_signal_val_int(self, action: int, value: int) -> None: ...
     def set_signal_val_real(self, action: int, value: float) -> None: ...
     def set_signal_val_str(self, action: int, value: bytes) -> None: ...
+    def write_array(
+        self, action: int, first: int, count: int, format: int, buffer: Any
+    ) -> None: ...
     def __eq__(self, other: object) -> bool: ...
     def __ne__(self, other: object) -> bool: ...
     def __hash__(self) -> int: ...
@@ -90,7 +136,38 @@ def register_timed_callback(
 def register_value_change_callback(
     signal: gpi_sim_hdl, func: Callable[..., Any], edge: int, *args: Any
 ) -> gpi_cb_hdl: ...
+def register_masked_value_change_callback(
+    signal: gpi_sim_hdl,
+    func: Callable[..., Any],
+    mask: str,
+    value: str | None,
+    *args: Any,
+) -> gpi_cb_hdl: ...
+def create_value_change_group() -> gpi_cb_group: ...
 def stop_simulator() -> None: ...
+def get_stats() -> dict[str, Any]: ...
+def reset_stats() -> None: ...
+def get_memory_stats() -> dict[str, int]: ...
+def set_slow_callback_threshold(threshold_ns: int) -> None: ...
+def set_readonly_value_cache(enable: bool) -> None: ...
+def set_write_elision(enable: bool) -> None: ...
+def set_callback_batching(
+    handler: Callable[[list[tuple[Callable[..., Any], tuple[Any, ...]]]], None]
+    | None,
+) -> None: ...
+def fork() -> int: ...
+def checkpoint_save(filename: str) -> None: ...
+def set_waveform_dumping(enable: bool) -> None: ...
+def get_signal_vals_real(handles: Sequence[gpi_sim_hdl], buffer: Any) -> None: ...
+def set_signal_vals_real(
+    action: int, handles: Sequence[gpi_sim_hdl], buffer: Any
+) -> None: ...
+def load_memory(
+    handle: gpi_sim_hdl, path: str, format: int, offset: int = 0
+) -> None: ...
+def dump_memory(
+    handle: gpi_sim_hdl, path: str, format: int, offset: int = 0
+) -> None: ...
 
 class cpp_clock:
     def __init__(self, signal: gpi_sim_hdl) -> None: ...
@@ -104,4 +181,5 @@ def initialize_logger(
     log_func: Callable[[Logger, int, str, int, str, str], None],
     get_logger: Callable[[str], Logger],
 ) -> None: ...
+def clear_logger_level_cache() -> None: ...
 def set_sim_event_callback(sim_event_callback: Callable[[str], None]) -> None: ...
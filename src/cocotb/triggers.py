@@ -13,9 +13,11 @@ from cocotb._extended_awaitables import (
     with_timeout,
 )
 from cocotb._gpi_triggers import (
+    AnyValueChange,
     Edge,
     FallingEdge,
     GPITrigger,
+    MaskedValueChange,
     NextTimeStep,
     ReadOnly,
     ReadWrite,
@@ -26,6 +28,7 @@ from cocotb._gpi_triggers import (
 )
 
 __all__ = (
+    "AnyValueChange",
     "ClockCycles",
     "Combine",
     "Edge",
@@ -34,6 +37,7 @@ __all__ = (
     "First",
     "GPITrigger",
     "Lock",
+    "MaskedValueChange",
     "NextTimeStep",
     "NullTrigger",
     "ReadOnly",
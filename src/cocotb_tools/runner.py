@@ -1331,10 +1331,21 @@ class Verilator(Runner):
 
        * ``waves=True`` *must* be given to :meth:`.build` if either ``waves`` or ``gui`` are to be used during :meth:`.test`.
        * Does not support the ``pre_cmd`` argument to :meth:`.test`.
+       * Reads :make:var:`VERILATOR_THREADS`, :make:var:`VERILATOR_TRACE_THREADS` and :make:var:`VERILATOR_CPU_AFFINITY` from the environment.
+         ``--threads`` given in ``build_args`` is also passed to the simulation.
     """
 
     supported_gpi_interfaces = {"verilog": ["vpi"]}
 
+    def _threads_option(self) -> _Command:
+        """Return the ``--threads`` option the model is built with, if any."""
+        build_args = [str(arg) for arg in getattr(self, "build_args", [])]
+        if "--threads" in build_args:
+            i = build_args.index("--threads")
+            return build_args[i : i + 2]
+        threads = os.getenv("VERILATOR_THREADS")
+        return ["--threads", threads] if threads else []
+
     def _set_env(self) -> None:
         super()._set_env()
         if "COCOTB_TRUST_INERTIAL_WRITES" not in self.env:
@@ -1418,9 +1429,20 @@ class Verilator(Runner):
                 "-o",
                 self.hdl_toplevel,
                 "-LDFLAGS",
-                f"-Wl,-rpath,{cocotb_tools.config.libs_dir} -L{cocotb_tools.config.libs_dir} -lcocotbvpi_verilator",
+                f"-Wl,-rpath,{cocotb_tools.config.libs_dir} -L{cocotb_tools.config.libs_dir} -lcocotbvpi_verilator -lgpi",
             ]
             + (["--trace"] if self.waves else [])
+            + ([] if "--threads" in self.build_args else self._threads_option())
+            + (
+                ["--trace-threads", os.environ["VERILATOR_TRACE_THREADS"]]
+                if self.waves and os.getenv("VERILATOR_TRACE_THREADS")
+                else []
+            )
+            + (
+                ["-CFLAGS", "-DCOCOTB_VERILATOR_SAVABLE"]
+                if "--savable" in self.build_args
+                else []
+            )
             + [arg for arg in self.build_args if type(arg) in (str, Verilog)]
             + (
                 ["--timescale", "{}/{}".format(*self.timescale)]
@@ -1459,9 +1481,16 @@ class Verilator(Runner):
             raise RuntimeError("pre_cmd is not implemented for Verilator.")
 
         out_file = self.build_dir / self.sim_hdl_toplevel
+        cpu_affinity = os.getenv("VERILATOR_CPU_AFFINITY")
         return [
             [str(out_file)]
             + (["--trace"] if self.waves or self.gui else [])
+            + ([] if "--threads" in self.test_args else self._threads_option())
+            + (
+                ["--cpu-affinity", cpu_affinity]
+                if cpu_affinity and "--cpu-affinity" not in self.test_args
+                else []
+            )
             + self.test_args
             + self.plusargs
         ]
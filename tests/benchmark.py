@@ -56,3 +56,31 @@ def test_matrix_multiplier_icarus(benchmark):
 
 def test_matrix_multiplier_nvc(benchmark):
     build_and_run_matrix_multiplier(benchmark, "nvc")
+
+
+def build_and_run_signal_access(benchmark, sim):
+    tests_path = Path(__file__).resolve().parent
+    proj_path = tests_path / "designs" / "sample_module"
+
+    sys.path.append(str(tests_path))
+
+    runner = get_runner(sim)
+
+    runner.build(
+        hdl_toplevel="sample_module",
+        sources=[proj_path / "sample_module.sv"],
+        build_dir="sim_build_signal_access",
+    )
+
+    @benchmark
+    def run_test():
+        runner.test(
+            hdl_toplevel="sample_module",
+            hdl_toplevel_lang="verilog",
+            test_module="signal_access_tests",
+            seed=123456789,
+        )
+
+
+def test_signal_access_icarus(benchmark):
+    build_and_run_signal_access(benchmark, "icarus")
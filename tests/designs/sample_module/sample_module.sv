@@ -169,6 +169,7 @@ reg [7:0]  array_4_downto_7[4:7];
 reg [7:0]  array_3_downto_0[3:0];
 reg [7:0]  array_0_to_3[0:3];
 reg [7:0]  array_2d[0:1][31:28];
+real       array_real[0:2];
 always @(posedge stream_in_valid) begin
     // Ensure internal array is not optimized out
     array_7_downto_4[4] <= 0;
@@ -177,6 +178,7 @@ always @(posedge stream_in_valid) begin
     array_3_downto_0[0] <= 0;
     array_0_to_3[3] <= 0;
     array_2d[1][28] <= 0;
+    array_real[0] <= 0.0;
 end
 
 //For testing type assigned to logic
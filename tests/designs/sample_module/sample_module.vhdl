@@ -77,6 +77,9 @@ architecture impl of sample_module is
     type twoDimArrayType is array (natural range <>) of unsignedArrayType(31 downto 28);
     signal array_2d         : twoDimArrayType(0 to 1);
 
+    type realArrayType is array (natural range <>) of real;
+    signal array_real       : realArrayType(0 to 2);
+
     constant NUM_OF_MODULES : natural := 4;
     signal temp             : std_logic_vector(NUM_OF_MODULES-1 downto 0);
 
@@ -0,0 +1,67 @@
+# Copyright cocotb contributors
+# Licensed under the Revised BSD License, see LICENSE for details.
+# SPDX-License-Identifier: BSD-3-Clause
+import os
+import sys
+
+import pytest
+from test_cocotb import (
+    compile_args,
+    gpi_interfaces,
+    hdl_toplevel,
+    hdl_toplevel_lang,
+    sim_args,
+    sim_build,
+    sources,
+    tests_dir,
+)
+
+import cocotb
+from cocotb.clock import Clock
+from cocotb.triggers import ClockCycles
+from cocotb_tools.runner import get_runner
+
+sys.path.insert(0, os.path.join(tests_dir, "pytest"))
+test_module = os.path.basename(os.path.splitext(__file__)[0])
+sim = os.getenv(
+    "SIM",
+    "icarus" if os.getenv("HDL_TOPLEVEL_LANG", "verilog") == "verilog" else "nvc",
+)
+
+
+@cocotb.test()
+async def clock_threaded_design(dut):
+    cpu = int(os.environ["VERILATOR_CPU_AFFINITY"])
+    assert os.sched_getaffinity(0) == {cpu}
+    clock = Clock(dut.clk, 10, unit="us")
+    cocotb.start_soon(clock.start())
+    await ClockCycles(dut.clk, 10)
+
+
+@pytest.mark.simulator_required
+@pytest.mark.skipif(
+    sim != "verilator" or not hasattr(os, "sched_getaffinity"),
+    reason="Skipping test because it is only for the Verilator simulator on Linux",
+)
+def test_verilator_threads(monkeypatch):
+    monkeypatch.setenv("VERILATOR_THREADS", "2")
+    monkeypatch.setenv("VERILATOR_CPU_AFFINITY", str(min(os.sched_getaffinity(0))))
+    build_dir = os.path.join(sim_build, "test_verilator_threads")
+
+    runner = get_runner(sim)
+    runner.build(
+        always=True,
+        clean=True,
+        sources=sources,
+        hdl_toplevel=hdl_toplevel,
+        build_dir=build_dir,
+        build_args=compile_args,
+    )
+    runner.test(
+        hdl_toplevel_lang=hdl_toplevel_lang,
+        hdl_toplevel=hdl_toplevel,
+        gpi_interfaces=gpi_interfaces,
+        test_module=test_module,
+        test_args=sim_args,
+        build_dir=build_dir,
+    )
@@ -0,0 +1,36 @@
+# Copyright cocotb contributors
+# Licensed under the Revised BSD License, see LICENSE for details.
+# SPDX-License-Identifier: BSD-3-Clause
+
+"""Microbenchmark of the calls from Python into the simulator module."""
+
+import cocotb
+from cocotb.triggers import Timer
+
+CALLS = 100_000
+
+DEPOSIT = 0
+
+
+def _noop() -> None:
+    pass
+
+
+@cocotb.test()
+async def signal_access(dut):
+    hdl = dut.stream_in_data._handle
+    for i in range(CALLS):
+        hdl.set_signal_val_int(DEPOSIT, i & 0xFF)
+        hdl.get_signal_val_long()
+        hdl.get_handle_by_name("stream_in_data")
+    await Timer(1, "ns")
+
+
+@cocotb.test()
+async def callback_registration(dut):
+    from cocotb import simulator
+
+    for _ in range(CALLS):
+        simulator.register_timed_callback(1, _noop).deregister()
+        simulator.register_readonly_callback(_noop).deregister()
+    await Timer(1, "ns")
@@ -5,6 +5,8 @@
 Tests for edge triggers
 
 * ValueChange
+* MaskedValueChange
+* AnyValueChange
 * RisingEdge
 * FallingEdge
 * ClockCycles
@@ -17,12 +19,16 @@ import pytest
 from common import assert_takes
 
 import cocotb
+from cocotb import simulator
 from cocotb.clock import Clock
+from cocotb.simtime import get_sim_time
 from cocotb.triggers import (
+    AnyValueChange,
     ClockCycles,
     Combine,
     FallingEdge,
     First,
+    MaskedValueChange,
     ReadOnly,
     RisingEdge,
     SimTimeoutError,
@@ -470,3 +476,88 @@ async def issue_376_different_edges(dut):
     Clock(dut.clk, 2500).start()
     cocotb.start_soon(wait_for_rising_edge(dut.clk))
     await cocotb.start_soon(wait_for_falling_edge(dut.clk))
+
+
+@cocotb.test
+async def test_masked_value_change(dut):
+    signal = dut.stream_in_data_dqword
+    signal.value = 0
+    await Timer(1, "ns")
+
+    async def drive():
+        for value in (0x10, 0x13, 0x12, 0x11):
+            signal.value = value
+            await Timer(1, "ns")
+
+    cocotb.start_soon(drive())
+    # the change to 0x10 doesn't touch the watched bits
+    await MaskedValueChange(signal, 0b11)
+    assert signal.value == 0x13
+    # the change to 0x12 doesn't reach the target value
+    await MaskedValueChange(signal, 0b11, 0b01)
+    assert signal.value == 0x11
+
+
+@cocotb.test
+async def test_masked_value_change_bad_args(dut):
+    with pytest.raises(ValueError):
+        MaskedValueChange(dut.stream_in_data_dqword, "101")
+    with pytest.raises(ValueError):
+        MaskedValueChange(dut.stream_in_data_dqword, 1, 2**128)
+    with pytest.raises(ValueError):
+        MaskedValueChange(dut.stream_in_data_dqword, 0)
+    with pytest.raises(TypeError):
+        MaskedValueChange(dut.clk, 1)
+
+
+@cocotb.test
+async def test_any_value_change(dut):
+    a = dut.stream_in_data
+    b = dut.stream_in_data_dqword
+    c = dut.stream_in_valid
+    for signal in (a, b, c):
+        signal.value = 0
+    await Timer(1, "ns")
+
+    async def drive():
+        a.value = 1
+        b.value = 1
+        await Timer(1, "ns")
+        c.value = 1
+        await Timer(1, "ns")
+        b.value = 2
+        await Timer(1, "ns")
+        c.value = 0
+
+    trigger = AnyValueChange(a, b)
+    cocotb.start_soon(drive())
+    start = get_sim_time("ns")
+    # both changes in the same time step fire once
+    await trigger
+    assert set(trigger.changed) == {a, b}
+    assert get_sim_time("ns") == start
+
+    trigger.remove(b)
+    trigger.add(c)
+    assert set(trigger.signals) == {a, c}
+    await trigger
+    assert trigger.changed == [c]
+    assert get_sim_time("ns") == start + 1
+    # b isn't watched anymore
+    await trigger
+    assert trigger.changed == [c]
+    assert get_sim_time("ns") == start + 3
+
+
+@cocotb.test
+async def test_any_value_change_bad_args(dut):
+    with pytest.raises(TypeError):
+        AnyValueChange(dut.stream_in_data, dut)
+    trigger = AnyValueChange(dut.stream_in_data)
+    with pytest.raises(ValueError):
+        trigger.remove(dut.stream_in_valid)
+
+    # the GPI rejects objects which aren't signals too
+    group = simulator.create_value_change_group()
+    with pytest.raises(RuntimeError):
+        group.add(dut._handle)
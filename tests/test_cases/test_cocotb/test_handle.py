@@ -5,16 +5,26 @@
 Tests for handles
 """
 
+import array
 import logging
 import os
 import random
+import struct
+import tempfile
 from typing import Any
 
 import pytest
 
 import cocotb
 import cocotb.triggers
-from cocotb.handle import Immediate, LogicArrayObject, StringObject, _Limits
+from cocotb import simulator
+from cocotb.handle import (
+    Immediate,
+    LogicArrayObject,
+    StringObject,
+    _GPISetAction,
+    _Limits,
+)
 from cocotb.triggers import FallingEdge, Timer, ValueChange
 from cocotb.types import Logic, LogicArray
 from cocotb_tools.sim_versions import RivieraVersion
@@ -131,6 +141,22 @@ async def test_int_values(
     await int_values_test(signal, width, setimmediate, limits)
 
 
+@cocotb.test
+async def test_int_values_same_step(_) -> None:
+    """Test writing signals of every width in the same time step."""
+    for signal in signal_widths.values():
+        signal.value = 0
+    await Timer(1, "ns")
+
+    values = {width: random.getrandbits(width) for width in signal_widths}
+    for width, signal in signal_widths.items():
+        signal.value = values[width]
+    await Timer(1, "ns")
+
+    for width, signal in signal_widths.items():
+        assert signal.value.to_unsigned() == values[width]
+
+
 async def int_values_test(
     signal: LogicArrayObject,
     n_bits: int,
@@ -332,6 +358,36 @@ async def test_real_assign_int(dut):
     assert got == val, "Values didn't match!"
 
 
+# GHDL unable to find real signals (gh-2589)
+# iverilog unable to find real signals (gh-2590)
+@cocotb.test(
+    expect_error=AttributeError
+    if SIM_NAME.startswith("icarus")
+    else AttributeError
+    if SIM_NAME.startswith("ghdl")
+    else ()
+)
+async def test_real_buffer_access(dut):
+    """Set and get several real signals through a buffer of doubles."""
+    handles = [dut.stream_in_real._handle]
+    simulator.set_signal_vals_real(
+        _GPISetAction.DEPOSIT.value, handles, array.array("d", [1.25])
+    )
+    await Timer(1, "step")
+    await Timer(1, "step")
+
+    values = array.array("d", [0.0, 0.0])
+    simulator.get_signal_vals_real(
+        [dut.stream_in_real._handle, dut.stream_out_real._handle], values
+    )
+    assert values.tolist() == [1.25, 1.25]
+
+    with pytest.raises(TypeError):
+        simulator.get_signal_vals_real([dut.stream_in_int._handle], values)
+    with pytest.raises(ValueError):
+        simulator.get_signal_vals_real(handles * 3, values)
+
+
 # identifiers starting with `_` are illegal in VHDL
 @cocotb.test(skip=LANGUAGE in ("vhdl"))
 async def test_access_underscore_name(dut):
@@ -595,3 +651,207 @@ async def test_setattr_error_msg(dut: Any) -> None:
         dut.example = 1
     with pytest.raises(AttributeError, match=r"'stream_in_data'.*\.value"):
         dut.stream_in_data = 1
+
+
+@cocotb.test
+async def test_gpi_handle_identity(dut) -> None:
+    # looking up the same object twice gives the same GPI handle object
+    hdl = dut._handle.get_handle_by_name("stream_in_data")
+    assert hdl is dut._handle.get_handle_by_name("stream_in_data")
+    assert hdl is dut.stream_in_data._handle
+    assert hdl.get_name_string() is hdl.get_name_string()
+
+
+@cocotb.test
+async def test_gpi_object_info(dut) -> None:
+    # the single call agrees with the individual property getters
+    for hdl in (dut._handle, dut.stream_in_data._handle):
+        info = hdl.get_info()
+        assert info.type == hdl.get_type()
+        assert info.type_string == hdl.get_type_string()
+        assert info.name == hdl.get_name_string()
+        assert info.const == hdl.get_const()
+        assert info.indexable == hdl.get_indexable()
+        assert info.num_elems == hdl.get_num_elems()
+        assert info.range == hdl.get_range()
+        assert info.definition_name == hdl.get_definition_name()
+        assert info.definition_file == hdl.get_definition_file()
+
+
+@cocotb.test
+async def test_gpi_handle_release(dut) -> None:
+    # handles that are no longer referenced are released and can be found again
+    baseline = simulator.get_memory_stats()["handles"]
+    for _ in range(100):
+        hdl = dut._handle.get_handle_by_name("stream_in_data_dqword")
+        assert hdl.get_name_string() == "stream_in_data_dqword"
+        assert hdl.get_num_elems() == 128
+        del hdl
+    assert simulator.get_memory_stats()["handles"] == baseline
+
+
+@cocotb.test
+async def test_gpi_iterator_keeps_parent(dut) -> None:
+    hdl = dut._handle.get_handle_by_name("array_2d")
+    expected = [h.get_name_string() for h in hdl.iterate(simulator.OBJECTS)]
+    # the iterator keeps the object alive once nothing else refers to it
+    it = hdl.iterate(simulator.OBJECTS)
+    del hdl
+    assert [h.get_name_string() for h in it] == expected
+
+
+@cocotb.test
+async def test_gpi_memory_stats(dut) -> None:
+    stats = simulator.get_memory_stats()
+    assert set(stats) == {"handles", "handle_bytes", "strings", "string_bytes"}
+    assert stats["handles"] > 0
+    assert stats["strings"] > 0
+
+    # repeated lookups of the same object don't grow the string table
+    dut.stream_in_data_dqword._handle
+    before = simulator.get_memory_stats()["strings"]
+    for _ in range(10):
+        dut._handle.get_handle_by_name("stream_in_data_dqword")
+    assert simulator.get_memory_stats()["strings"] == before
+
+
+@cocotb.test
+async def test_logic_array_slices(dut) -> None:
+    dut.stream_in_data_dqword.value = 0
+    await Timer(1, "ns")
+
+    # both slices take effect in the same time step
+    dut.stream_in_data_dqword.set_slice(47, 40, 0xA5)
+    dut.stream_in_data_dqword.set_slice(3, 0, "1101")
+    await Timer(1, "ns")
+    value = dut.stream_in_data_dqword.value
+    assert value[47:40] == LogicArray("10100101")
+    assert value[3:0] == LogicArray("1101")
+    assert value[39:4] == LogicArray(0, 36)
+
+    assert dut.stream_in_data_dqword.get_slice(47, 40) == LogicArray("10100101")
+    assert dut.stream_in_data_dqword.get_slice(44, 44) == LogicArray("0")
+
+    with pytest.raises(IndexError):
+        dut.stream_in_data_dqword.get_slice(40, 47)
+    with pytest.raises(ValueError):
+        dut.stream_in_data_dqword.set_slice(47, 40, 0x1FF)
+
+
+@cocotb.test
+async def test_logic_array_slices_merged(dut) -> None:
+    dut.stream_in_data_dqword.value = 0
+    await Timer(1, "ns")
+
+    # slices set before a write phase are merged, the last one winning where
+    # they overlap, and don't rely on the simulator writing single bits
+    dut.stream_in_data_dqword.set_slice(15, 8, 0xFF)
+    dut.stream_in_data_dqword.set_slice(3, 0, "1010")
+    dut.stream_in_data_dqword.set_slice(11, 8, 0)
+    await Timer(1, "ns")
+    value = dut.stream_in_data_dqword.value
+    assert value[15:0] == LogicArray("1111000000001010")
+    assert value[127:16] == LogicArray(0, 112)
+
+
+# GHDL unable to put values on nested array types (gh-2588)
+@cocotb.test(expect_error=Exception if SIM_NAME.startswith("ghdl") else ())
+async def test_array_read_into_write_from(dut) -> None:
+    dut.array_7_downto_4.write_from(bytes([1, 2, 3, 4]))
+    await Timer(1, "ns")
+    assert dut.array_7_downto_4.value == [1, 2, 3, 4]
+
+    buf = bytearray(4)
+    assert dut.array_7_downto_4.read_into(buf) == 4
+    assert buf == bytes([1, 2, 3, 4])
+
+    # partial access starting at an index, clipped to the end of the array
+    assert dut.array_7_downto_4.write_from(bytes([10, 20, 30]), start=5) == 2
+    await Timer(1, "ns")
+    assert dut.array_7_downto_4.value == [1, 2, 10, 20]
+    buf = bytearray(8)
+    assert dut.array_7_downto_4.read_into(buf, start=6) == 3
+    assert buf[:3] == bytes([2, 10, 20])
+
+    with pytest.raises(IndexError):
+        dut.array_7_downto_4.read_into(buf, start=8)
+
+
+# GHDL unable to find real signals (gh-2589)
+# iverilog unable to find real signals (gh-2590)
+@cocotb.test(
+    expect_error=AttributeError
+    if SIM_NAME.startswith(("icarus", "ghdl"))
+    else ()
+)
+async def test_real_array_read_into_write_from(dut) -> None:
+    dut.array_real.write_from(array.array("d", [0.5, -1.25, 3e9]))
+    await Timer(1, "ns")
+    assert dut.array_real[1].value == -1.25
+
+    buf = array.array("d", [0.0] * 3)
+    assert dut.array_real.read_into(buf) == 3
+    assert buf.tolist() == [0.5, -1.25, 3e9]
+
+    assert dut.array_real.write_from(array.array("d", [7.5]), start=2) == 1
+    await Timer(1, "ns")
+    assert dut.array_real.read_into(buf, start=1) == 2
+    assert buf.tolist()[:2] == [-1.25, 7.5]
+
+
+# GHDL unable to put values on nested array types (gh-2588)
+@cocotb.test(expect_error=Exception if SIM_NAME.startswith("ghdl") else ())
+async def test_memory_image_load_dump(dut) -> None:
+    with tempfile.TemporaryDirectory() as tmp:
+        mem = dut.array_7_downto_4._handle
+
+        bin_path = os.path.join(tmp, "mem.bin")
+        with open(bin_path, "wb") as f:
+            f.write(bytes([5, 6, 7, 8]))
+        simulator.load_memory(mem, bin_path, simulator.MEM_BIN)
+        await Timer(1, "ns")
+        assert dut.array_7_downto_4.value == [5, 6, 7, 8]
+
+        # addresses are relative to the offset, other elements are kept
+        hex_path = os.path.join(tmp, "mem.hex")
+        with open(hex_path, "w") as f:
+            f.write("// comment\n@1 a_b\nff /* x */\n")
+        simulator.load_memory(mem, hex_path, simulator.MEM_HEX, 1)
+        await Timer(1, "ns")
+        assert dut.array_7_downto_4.value == [5, 6, 0xAB, 0xFF]
+
+        with pytest.raises(RuntimeError):
+            simulator.load_memory(mem, hex_path, simulator.MEM_HEX, 2)
+
+        dump_path = os.path.join(tmp, "dump.hex")
+        simulator.dump_memory(mem, dump_path, simulator.MEM_HEX)
+        with open(dump_path) as f:
+            assert f.read() == "05\n06\nab\nff\n"
+        simulator.dump_memory(mem, bin_path, simulator.MEM_BIN)
+        with open(bin_path, "rb") as f:
+            assert f.read() == bytes([5, 6, 0xAB, 0xFF])
+
+        # BIN images have no addresses to apply an offset to
+        with pytest.raises(RuntimeError):
+            simulator.dump_memory(mem, bin_path, simulator.MEM_BIN, -0x10)
+
+        # segments which don't fit are rejected before they are zero-filled
+        elf_path = os.path.join(tmp, "mem.elf")
+        with open(elf_path, "wb") as f:
+            ident = b"\x7fELF" + bytes([1, 1, 1]) + bytes(9)
+            header = (2, 0, 1, 0, 52, 0, 0, 52, 32, 1, 0, 0, 0)
+            f.write(struct.pack("<16sHHIIIIIHHHHHH", ident, *header))
+            # PT_LOAD of 4 GiB of zeroes
+            f.write(struct.pack("<8I", 1, 0, 0, 0, 0, 0xFFFFFFF0, 0, 0))
+        with pytest.raises(RuntimeError):
+            simulator.load_memory(mem, elf_path, simulator.MEM_ELF)
+
+        # a negative offset places the first element after address 0
+        simulator.dump_memory(mem, dump_path, simulator.MEM_HEX, -0x10)
+        with open(dump_path) as f:
+            assert f.read() == "@10\n05\n06\nab\nff\n"
+        dut.array_7_downto_4.value = [0, 0, 0, 0]
+        await Timer(1, "ns")
+        simulator.load_memory(mem, dump_path, simulator.MEM_HEX, -0x10)
+        await Timer(1, "ns")
+        assert dut.array_7_downto_4.value == [5, 6, 0xAB, 0xFF]
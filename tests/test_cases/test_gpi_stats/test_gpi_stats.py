@@ -0,0 +1,149 @@
+# Copyright cocotb contributors
+# Licensed under the Revised BSD License, see LICENSE for details.
+# SPDX-License-Identifier: BSD-3-Clause
+
+import cocotb
+from cocotb import simulator
+from cocotb.triggers import ReadOnly, Timer
+
+
+@cocotb.test()
+async def test_stats_count_callbacks_and_accesses(dut):
+    simulator.reset_stats()
+
+    for i in range(5):
+        dut.stream_in_data.value = i
+        await Timer(1, "ns")
+        _ = dut.stream_in_data.value
+    await ReadOnly()
+
+    stats = simulator.get_stats()
+    timed = stats["callbacks"]["timed"]
+    assert timed["count"] >= 5
+    assert sum(timed["histogram"]) == timed["count"]
+    assert stats["callbacks"]["readonly"]["count"] >= 1
+    assert sum(stats["reads"].values()) >= 5
+    assert sum(stats["writes"].values()) >= 5
+    assert stats["gpi_time_ns"] >= timed["time_ns"]
+
+
+@cocotb.test()
+async def test_stats_reset(_):
+    await Timer(1, "ns")
+    simulator.reset_stats()
+    stats = simulator.get_stats()
+    assert all(cb["count"] == 0 for cb in stats["callbacks"].values())
+    assert sum(stats["reads"].values()) == 0
+    assert sum(stats["writes"].values()) == 0
+
+
+@cocotb.test()
+async def test_slow_callback_threshold(_):
+    simulator.reset_stats()
+    simulator.set_slow_callback_threshold(1)
+    await Timer(1, "ns")
+    simulator.set_slow_callback_threshold(0)
+    stats = simulator.get_stats()
+    assert stats["slow_callbacks"] >= 1
+    assert stats["slow_callback_threshold_ns"] == 0
+
+
+@cocotb.test(skip=not cocotb.SIM_NAME.lower().startswith("verilator"))
+async def test_verilator_idle_time_steps(dut):
+    await Timer(1, "ns")
+    simulator.reset_stats()
+    # only timers are pending, so the model need not be evaluated
+    for _ in range(10):
+        await Timer(1, "ns")
+    stats = simulator.get_stats()["simulator"]
+    assert stats["idle_time_steps"] >= 10
+    assert stats["evals"] < stats["time_steps"]
+
+    simulator.reset_stats()
+    for i in range(10):
+        dut.stream_in_data.value = i
+        await Timer(1, "ns")
+    stats = simulator.get_stats()["simulator"]
+    assert stats["evals"] >= 10
+
+
+@cocotb.test()
+async def test_readonly_value_cache(dut):
+    simulator.set_readonly_value_cache(True)
+    try:
+        dut.stream_in_data.value = 5
+        await Timer(1, "ns")
+        simulator.reset_stats()
+        # outside of ReadOnly reads always go to the simulator
+        assert dut.stream_in_data.value == 5
+        assert dut.stream_in_data.value == 5
+        assert simulator.get_stats()["value_cache_hits"] == 0
+
+        await ReadOnly()
+        first = dut.stream_in_data.value
+        assert dut.stream_in_data.value == first
+        assert simulator.get_stats()["value_cache_hits"] == 1
+
+        # the cache doesn't outlive the callback
+        await Timer(1, "ns")
+        dut.stream_in_data.value = 6
+        await ReadOnly()
+        assert dut.stream_in_data.value == 6
+    finally:
+        simulator.set_readonly_value_cache(False)
+
+
+@cocotb.test()
+async def test_write_elision(dut):
+    simulator.set_write_elision(True)
+    try:
+        simulator.reset_stats()
+        for _ in range(3):
+            dut.stream_in_data.value = 3
+            await Timer(1, "ns")
+        elided = simulator.get_stats()["elided_writes"]
+        assert elided >= 1
+
+        dut.stream_in_data.value = 4
+        await Timer(1, "ns")
+        assert simulator.get_stats()["elided_writes"] == elided
+        assert dut.stream_in_data.value == 4
+
+        # without a change the same value is dropped again...
+        dut.stream_in_data.value = 4
+        await Timer(1, "ns")
+        dut.stream_in_data.value = 4
+        await Timer(1, "ns")
+        assert simulator.get_stats()["elided_writes"] == elided + 1
+        elided += 1
+
+        # ...but reading forgets the last value written
+        assert dut.stream_in_data.value == 4
+        dut.stream_in_data.value = 4
+        await Timer(1, "ns")
+        assert simulator.get_stats()["elided_writes"] == elided
+
+        # the callbacks watching for changes aren't user callbacks
+        assert simulator.get_stats()["callbacks"]["other"]["count"] == 0
+    finally:
+        simulator.set_write_elision(False)
+
+
+@cocotb.test(skip=not cocotb.SIM_NAME.lower().startswith("verilator"))
+async def test_callback_batching(_):
+    woken = []
+
+    async def wait(i):
+        await Timer(2, "ns")
+        woken.append(i)
+
+    simulator.set_callback_batching(cocotb._scheduler_inst._sim_react_batch)
+    try:
+        simulator.reset_stats()
+        tasks = [cocotb.start_soon(wait(i)) for i in range(8)]
+        for task in tasks:
+            await task
+        assert sorted(woken) == list(range(8))
+        assert simulator.get_stats()["batched_callbacks"] >= 8
+    finally:
+        simulator.set_callback_batching(None)
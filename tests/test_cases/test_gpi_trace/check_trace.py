@@ -0,0 +1,26 @@
+# Copyright cocotb contributors
+# Licensed under the Revised BSD License, see LICENSE for details.
+# SPDX-License-Identifier: BSD-3-Clause
+
+import json
+import sys
+
+with open(sys.argv[1]) as f:
+    trace = json.load(f)
+
+events = trace["traceEvents"]
+categories = {e["cat"] for e in events}
+assert {"callback", "register", "signal"} <= categories, categories
+
+begins = sum(1 for e in events if e["ph"] == "B")
+ends = sum(1 for e in events if e["ph"] == "E")
+assert begins > 0
+# the shutdown callback may not return before the trace is written
+assert begins - ends in (0, 1), (begins, ends)
+
+assert any(
+    e["cat"] == "signal" and e["args"].get("detail", "").endswith("stream_in_data")
+    for e in events
+)
+assert all("sim_time" in e["args"] for e in events)
+assert trace["otherData"]["dropped_events"] == 0
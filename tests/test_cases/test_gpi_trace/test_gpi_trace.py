@@ -0,0 +1,23 @@
+# Copyright cocotb contributors
+# Licensed under the Revised BSD License, see LICENSE for details.
+# SPDX-License-Identifier: BSD-3-Clause
+
+import cocotb
+from cocotb.triggers import RisingEdge, Timer
+
+
+@cocotb.test()
+async def test_generate_activity(dut):
+    for i in range(4):
+        dut.clk.value = i % 2
+        dut.stream_in_data.value = i
+        await Timer(1, "ns")
+        _ = dut.stream_in_data.value
+
+    async def toggle():
+        dut.clk.value = 0
+        await Timer(1, "ns")
+        dut.clk.value = 1
+
+    cocotb.start_soon(toggle())
+    await RisingEdge(dut.clk)
@@ -0,0 +1,12 @@
+# Copyright cocotb contributors
+# Licensed under the Revised BSD License, see LICENSE for details.
+# SPDX-License-Identifier: BSD-3-Clause
+
+import cocotb
+from cocotb.simtime import get_sim_time
+
+
+@cocotb.test()
+async def test_restore(dut):
+    assert get_sim_time("ns") >= 100
+    assert dut.stream_in_data.value == 42
@@ -0,0 +1,26 @@
+# Copyright cocotb contributors
+# Licensed under the Revised BSD License, see LICENSE for details.
+# SPDX-License-Identifier: BSD-3-Clause
+
+import pytest
+
+import cocotb
+from cocotb import simulator
+from cocotb.triggers import Timer
+
+
+@cocotb.test()
+async def test_save(dut):
+    dut.stream_in_data.value = 42
+    await Timer(100, "ns")
+    simulator.checkpoint_save("checkpoint.dat")
+    await Timer(1, "ns")
+    # the checkpoint was taken at the end of the previous time step
+    dut.stream_in_data.value = 7
+    await Timer(1, "ns")
+
+
+@cocotb.test()
+async def test_save_unwritable(dut):
+    with pytest.raises(RuntimeError):
+        simulator.checkpoint_save("no_such_dir/checkpoint.dat")
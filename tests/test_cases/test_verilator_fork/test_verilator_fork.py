@@ -0,0 +1,40 @@
+# Copyright cocotb contributors
+# Licensed under the Revised BSD License, see LICENSE for details.
+# SPDX-License-Identifier: BSD-3-Clause
+
+import os
+
+import cocotb
+from cocotb.regression import fork_checkpoint
+from cocotb.triggers import Timer
+
+parent_pid = os.getpid()
+
+
+@cocotb.test()
+async def test_warm_up(dut):
+    dut.stream_in_data.value = 42
+    await Timer(10, "ns")
+    fork_checkpoint(jobs=2)
+
+
+@cocotb.test()
+async def test_forked_a(dut):
+    assert os.getpid() != parent_pid
+    assert dut.stream_in_data.value == 42
+    dut.stream_in_data.value = 1
+    await Timer(10, "ns")
+
+
+@cocotb.test()
+async def test_forked_b(dut):
+    # starts from the warmed-up state, not from where test_forked_a ended
+    assert os.getpid() != parent_pid
+    assert dut.stream_in_data.value == 42
+    dut.stream_in_data.value = 2
+    await Timer(10, "ns")
+
+
+@cocotb.test(expect_fail=True)
+async def test_forked_failure_is_reported(dut):
+    assert dut.stream_in_data.value == 0
@@ -0,0 +1,28 @@
+# Copyright cocotb contributors
+# Licensed under the Revised BSD License, see LICENSE for details.
+# SPDX-License-Identifier: BSD-3-Clause
+
+import cocotb
+from cocotb import simulator
+from cocotb.clock import Clock
+from cocotb.simtime import get_sim_time
+from cocotb.triggers import Timer
+
+
+@cocotb.test()
+async def test_trace_window(dut):
+    Clock(dut.clk, 2, "ns").start()
+    await Timer(20, "ns")
+
+    simulator.set_waveform_dumping(True)
+    start = get_sim_time("step")
+    await Timer(10, "ns")
+    stop = get_sim_time("step")
+    # stopping flushes the trace file
+    simulator.set_waveform_dumping(False)
+    await Timer(10, "ns")
+
+    with open("dump.vcd") as f:
+        times = [int(line[1:]) for line in f if line.startswith("#")]
+    assert times
+    assert all(start <= t <= stop for t in times)